@@ -14,9 +14,11 @@ def parse_benchmark_results(xml_file):
             benchmark_name = benchmark.get('name')
             mean = benchmark.find('mean').get('value')
             stddev = benchmark.find('standardDeviation').get('value')
+            # Timings are in ns; counter reports (benchmark/perf_counters.hpp) name their unit
+            unit = benchmark.get('unit', 'ns')
 
             full_test_name = f"{test_name}/{benchmark_name}"
-            results[full_test_name] = (float(mean), float(stddev))
+            results[full_test_name] = (float(mean), float(stddev), unit)
 
     return results
 
@@ -27,8 +29,8 @@ def calculate_percentage_change(base, pr):
     if pr is None:
         return base[0], base[1], "N/A", "N/A", "N/A"
 
-    base_mean, base_stddev = base
-    pr_mean, pr_stddev = pr
+    base_mean, base_stddev, _ = base
+    pr_mean, pr_stddev, _ = pr
 
     change = ((pr_mean - base_mean) / base_mean) * 100 if base_mean != 0 else float('inf')
 
@@ -45,9 +47,11 @@ def generate_markdown_table(base_results, pr_results):
         base = base_results.get(test_name)
         pr = pr_results.get(test_name)
 
+        unit = (pr or base)[2]
+
         base_mean, base_stddev, pr_mean, pr_stddev, change = calculate_percentage_change(base, pr)
-        base_str = f"{base_mean:.2f}±{base_stddev:.2f}ns" if base_mean != "N/A" else "N/A"
-        pr_str = f"{pr_mean:.2f}±{pr_stddev:.2f}ns" if pr_mean != "N/A" else "N/A"
+        base_str = f"{base_mean:.2f}±{base_stddev:.2f}{unit}" if base_mean != "N/A" else "N/A"
+        pr_str = f"{pr_mean:.2f}±{pr_stddev:.2f}{unit}" if pr_mean != "N/A" else "N/A"
         change_str = f"{change:+.2f}%" if change != "N/A" else "N/A"
 
         row = f"| {test_name} | {base_str} | {pr_str} | {change_str} |\n"
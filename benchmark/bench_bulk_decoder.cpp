@@ -0,0 +1,58 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+#include <opengloves/bulk_decoder.hpp>
+
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace opengloves;
+
+namespace {
+  /// Log size in MiB, override with `OPENGLOVES_BENCH_LOG_MB` for the multi-hundred-MB runs
+  auto logSize() -> size_t {
+    const char* value = std::getenv("OPENGLOVES_BENCH_LOG_MB");
+    const auto megabytes = value != nullptr ? std::strtoul(value, nullptr, 10) : 8UL;
+    return std::max(1UL, megabytes) * 1024 * 1024;
+  }
+
+  auto makeLog(size_t size) -> std::string {
+    std::string log;
+    log.reserve(size + 64);
+    std::string buffer(64, '\0');
+
+    for (size_t i = 0; log.size() < size; i++) {
+      const auto value = static_cast<float>(i % 4096) / 4095.0f;
+      const auto written = AlphaEncoding::encodeOutput(
+        OutputForceFeedbackData{ .thumb = value, .index = 1.0f - value, .middle = 0.25f, .ring = 0.5f, .pinky = value },
+        reinterpret_cast<uint8_t*>(buffer.data()),
+        buffer.size()
+      );
+      log.append(buffer.data(), written);
+    }
+
+    return log;
+  }
+} // namespace
+
+TEST_CASE("Benchmark BulkDecoder", "[benchmark][bulk_decoder]") {
+  static const auto log = makeLog(logSize());
+  const auto* data = reinterpret_cast<const uint8_t*>(log.data());
+
+  std::vector<size_t> thread_counts;
+  for (size_t threads = 1; threads < std::thread::hardware_concurrency(); threads *= 2) {
+    thread_counts.push_back(threads);
+  }
+  thread_counts.push_back(std::max(1U, std::thread::hardware_concurrency()));
+
+  for (const auto threads : thread_counts) {
+    BulkDecoder decoder(threads);
+    std::vector<OutputData> output(decoder.countFrames(data, log.size()));
+
+    BENCHMARK(std::to_string(log.size() / 1024 / 1024) + " MiB decodeOutput, " + std::to_string(threads) + " threads") {
+      return decoder.decodeOutput(data, log.size(), output.data(), output.size());
+    };
+  }
+}
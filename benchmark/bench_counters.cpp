@@ -0,0 +1,71 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+
+#include "perf_counters.hpp"
+
+#include <cstdlib>
+#include <string>
+
+using namespace opengloves;
+using namespace opengloves::benchmark;
+
+// Hidden: run with `Benchmark "[counters]"`, and set `OPENGLOVES_BENCH_COUNTERS` to a path to also get the XML
+// report that `.github/scripts/compare-benchmarks.py` diffs
+TEST_CASE("Counters AlphaEncoding", "[.][benchmark][counters]") {
+  constexpr size_t SAMPLES = 20;
+  constexpr size_t CALLS = 10'000;
+
+  PerfCounters counters;
+  if (counters.available().empty()) {
+    WARN("perf_event_open is not available (no permission, or not Linux), nothing was counted");
+    return;
+  }
+
+  PerfCounterReport report("Counters AlphaEncoding");
+  std::string buffer(256, '\0');
+  auto* data = reinterpret_cast<uint8_t*>(buffer.data());
+
+  InputPeripheralData input_default;
+  report.measure(counters, "encodeInput default", SAMPLES, CALLS, [&] {
+    return AlphaEncoding::encodeInput(input_default, data, static_cast<int>(buffer.size()));
+  });
+
+  InputPeripheralData input_full;
+  for (auto& finger : input_full.curl.fingers) {
+    finger.curl = { 0.25F, 0.5F, 0.75F, 1.0F };
+  }
+  input_full.splay = { .thumb = 0.5, .index = 0.5, .middle = 0.5, .ring = 0.5, .pinky = 0.5 };
+  for (auto& button : input_full.buttons) {
+    button.press = true;
+  }
+  input_full.joystick = { .x = 0.5, .y = 0.5, .press = true };
+  report.measure(counters, "encodeInput full", SAMPLES, CALLS, [&] {
+    return AlphaEncoding::encodeInput(input_full, data, static_cast<int>(buffer.size()));
+  });
+
+  std::string input_frame(256, '\0');
+  input_frame.resize(static_cast<size_t>(
+      AlphaEncoding::encodeInput(input_full, reinterpret_cast<uint8_t*>(input_frame.data()), static_cast<int>(input_frame.size()))
+  ));
+  report.measure(counters, "decodeInput full", SAMPLES, CALLS, [&] {
+    return AlphaEncoding::decodeInput(reinterpret_cast<const uint8_t*>(input_frame.data()), input_frame.size());
+  });
+
+  const OutputData output = OutputForceFeedbackData{ .thumb = 0.25F, .index = 0.5F, .middle = 0.75F, .ring = 1.0F, .pinky = 0.0F };
+  report.measure(counters, "encodeOutput force feedback", SAMPLES, CALLS, [&] {
+    return AlphaEncoding::encodeOutput(output, data, static_cast<int>(buffer.size()));
+  });
+
+  const std::string output_frame = "A1024B2048C3071D4095E0\n";
+  report.measure(counters, "decodeOutput force feedback", SAMPLES, CALLS, [&] {
+    return AlphaEncoding::decodeOutput(reinterpret_cast<const uint8_t*>(output_frame.data()), output_frame.size());
+  });
+
+  WARN(report.table(counters));
+
+  if (const char* path = std::getenv("OPENGLOVES_BENCH_COUNTERS")) {
+    REQUIRE(report.write(path));
+  }
+}
@@ -0,0 +1,51 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/force_feedback.hpp>
+
+using namespace opengloves;
+
+TEST_CASE("Benchmark ForceFeedbackInterpolator", "[benchmark][force_feedback]") {
+  const std::array<std::pair<const char*, ForceFeedbackFingerConfig>, 3> configs = { {
+      { "step", { .interpolate = false, .max_slew_rate = 0.0F } },
+      { "interpolate", { .interpolate = true, .max_slew_rate = 0.0F } },
+      { "interpolate + slew", { .interpolate = true, .max_slew_rate = 5.0F } },
+  } };
+
+  for (const auto& [name, finger] : configs) {
+    ForceFeedbackInterpolatorConfig config{};
+    for (auto& finger_config : config.fingers.fingers) {
+      finger_config = finger;
+    }
+
+    ForceFeedbackInterpolator interpolator(config);
+    const std::array<OutputForceFeedbackData, 2> targets = { {
+        { .thumb = 0.2F, .index = 0.4F, .middle = 0.6F, .ring = 0.8F, .pinky = 1.0F },
+        { .thumb = 0.8F, .index = 0.6F, .middle = 0.4F, .ring = 0.2F, .pinky = 0.0F },
+    } };
+    Timestamp now = 0;
+    Timestamp arrival = 0;
+    size_t frame = 0;
+    interpolator.push(arrival, targets[0]);
+
+    // 1 kHz servo loop, with a new frame every 11.1 ms
+    BENCHMARK(std::string("tick, ") + name) {
+      now += 1'000;
+      if (now - arrival >= 11'111) {
+        arrival = now;
+        interpolator.push(arrival, targets[++frame % targets.size()]);
+      }
+      return interpolator.tick(now);
+    };
+  }
+
+  ForceFeedbackInterpolator interpolator;
+  const OutputForceFeedbackData target{ .thumb = 0.2F, .index = 0.4F, .middle = 0.6F, .ring = 0.8F, .pinky = 1.0F };
+  Timestamp arrival = 0;
+
+  BENCHMARK("push") {
+    arrival += 11'111;
+    interpolator.push(arrival, target);
+    return interpolator.interval();
+  };
+}
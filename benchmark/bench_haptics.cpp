@@ -0,0 +1,60 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/haptics.hpp>
+
+using namespace opengloves;
+
+TEST_CASE("Benchmark HapticsScheduler", "[benchmark][haptics]") {
+  for (const auto waveform : { HapticsWaveform_Constant, HapticsWaveform_Square, HapticsWaveform_Sine }) {
+    const std::string name = waveform == HapticsWaveform_Constant ? "constant" : (waveform == HapticsWaveform_Square ? "square" : "sine");
+
+    HapticsScheduler<8> scheduler({ .waveform = waveform });
+    Timestamp now = 0;
+    Timestamp refreshed = 0;
+
+    // A 2 s effect, with a full pool of weaker 1-2 s ones waiting behind it; refreshed every second, like a host
+    // re-sending its rumble, so the timed ticks always render a playing effect
+    const auto refresh = [&scheduler](Timestamp at) {
+      scheduler.push(at, { .frequency = 160.0F, .duration = 2.0F, .amplitude = 1.0F });
+      for (int i = 0; i < 8; i++) {
+        scheduler.push(
+            at,
+            { .frequency = 10.0F + 10.0F * static_cast<float>(i), .duration = 1.0F + 0.125F * static_cast<float>(i), .amplitude = 0.1F * static_cast<float>(i + 1) }
+        );
+      }
+    };
+    refresh(now);
+
+    REQUIRE(scheduler.playing());
+    REQUIRE(scheduler.pending() == 8);
+    REQUIRE(scheduler.tick(now) > 0.0F);
+
+    BENCHMARK("tick, " + name) {
+      now += 100;
+      if (now - refreshed >= 1'000'000) {
+        refreshed = now;
+        refresh(now);
+      }
+      return scheduler.tick(now);
+    };
+
+    REQUIRE(scheduler.playing());
+  }
+
+  HapticsScheduler<8> scheduler;
+  Timestamp now = 0;
+
+  // Worst case: every tick ends the playing effect and picks the next one from the pool
+  BENCHMARK("tick, switching effects") {
+    now += 100;
+    scheduler.push(now, { .frequency = 100.0F, .duration = 0.0001F, .amplitude = 1.0F });
+    scheduler.push(now, { .frequency = 300.0F, .duration = 0.0002F, .amplitude = 0.5F });
+    return scheduler.tick(now + 100);
+  };
+
+  BENCHMARK("push, merge") {
+    now += 100;
+    return scheduler.push(now, { .frequency = 100.0F, .duration = 0.02F, .amplitude = 0.5F });
+  };
+}
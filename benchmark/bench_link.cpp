@@ -0,0 +1,288 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+#include <opengloves/link.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace opengloves;
+
+namespace {
+  struct NamedLink {
+    const char* name;
+    LinkConfig config;
+  };
+
+  // BLE packet overhead in byte times: link layer and L2CAP/ATT headers, the empty acknowledgement, and the two
+  // 150 us inter-frame spaces; connection events are modelled as an even spread of packets over 7.5 ms.
+  const std::array<NamedLink, 5> LINKS{ {
+    { "UART 115200", { .baud_rate = 115'200, .queue_size = 256 } },
+    { "UART 460800", { .baud_rate = 460'800, .queue_size = 256 } },
+    { "UART 921600", { .baud_rate = 921'600, .queue_size = 256 } },
+    { "BLE 1M/23", { .baud_rate = 1'000'000, .bits_per_byte = 8, .mtu = 20, .packet_overhead = 65, .packet_interval = 1'875, .queue_size = 256 } },
+    { "BLE 2M/247", { .baud_rate = 2'000'000, .bits_per_byte = 8, .mtu = 244, .packet_overhead = 102, .packet_interval = 1'875, .queue_size = 512 } },
+  } };
+
+  template<typename Encoding, std::uint8_t Resolution = 0>
+  auto decodePeripheral(const uint8_t* frame, size_t frame_size, InputPeripheralData& input) -> bool {
+    return Encoding::decodeInputPeripheral(frame, frame_size, input, Resolution);
+  }
+
+  template<typename Encoding>
+  auto decodeForceFeedback(const uint8_t* frame, size_t frame_size, OutputForceFeedbackData& force_feedback) -> bool {
+    const auto output = Encoding::decodeOutput(frame, frame_size);
+    if (const auto* decoded = std::get_if<OutputForceFeedbackData>(&output)) {
+      force_feedback = *decoded;
+      return true;
+    }
+    return false;
+  }
+
+  /// Glove to host: frames are checked against the offered input on the `channels` they carry, within one analog step.
+  struct NamedEncoder {
+    const char* name;
+    int (*encode)(const InputPeripheralData&, uint8_t*, int);
+    bool (*decode)(const uint8_t*, size_t, InputPeripheralData&);
+    InputChannelMask channels;
+    float step;
+  };
+
+  const std::array<NamedEncoder, 4> ENCODERS{ {
+    { "12 bit",
+      [](const InputPeripheralData& input, uint8_t* buffer, int size) { return AlphaEncoding::encodeInputPeripheral(input, buffer, size); },
+      decodePeripheral<AlphaEncoding>,
+      InputChannel_All,
+      1.0F / 4095.0F },
+    { "8 bit",
+      [](const InputPeripheralData& input, uint8_t* buffer, int size) { return AlphaEncoding8::encodeInputPeripheral(input, buffer, size); },
+      decodePeripheral<AlphaEncoding8>,
+      InputChannel_All,
+      1.0F / 255.0F },
+    { "12b curl",
+      [](const InputPeripheralData& input, uint8_t* buffer, int size) {
+        return AlphaEncoding::encodeInputPeripheral(input, { InputChannel_Curl | InputChannel_Buttons, 0, 0 }, buffer, size);
+      },
+      decodePeripheral<AlphaEncoding>,
+      InputChannel_Curl | InputChannel_Buttons,
+      1.0F / 4095.0F },
+    { "8b curl",
+      [](const InputPeripheralData& input, uint8_t* buffer, int size) {
+        return AlphaEncoding::encodeInputPeripheral(input, { InputChannel_Curl | InputChannel_Buttons, 0, 8 }, buffer, size);
+      },
+      decodePeripheral<AlphaEncoding, 8>,
+      InputChannel_Curl | InputChannel_Buttons,
+      1.0F / 255.0F },
+  } };
+
+  /// Host to glove: force feedback, which the driver sends as often as the game updates it.
+  struct NamedOutputEncoder {
+    const char* name;
+    int (*encode)(const OutputForceFeedbackData&, uint8_t*, int);
+    bool (*decode)(const uint8_t*, size_t, OutputForceFeedbackData&);
+    float step;
+  };
+
+  const std::array<NamedOutputEncoder, 2> OUTPUT_ENCODERS{ {
+    { "12b ffb", AlphaEncoding::encodeOutputForceFeedback, decodeForceFeedback<AlphaEncoding>, 1.0F / 4095.0F },
+    { "8b ffb", AlphaEncoding8::encodeOutputForceFeedback, decodeForceFeedback<AlphaEncoding8>, 1.0F / 255.0F },
+  } };
+
+  auto near(float offered, float decoded, float step) -> bool { return std::fabs(offered - decoded) <= step * 1.01F; }
+
+  auto matches(const NamedEncoder& encoder, const InputPeripheralData& offered, const InputPeripheralData& decoded) -> bool {
+    const auto channels = encoder.channels;
+    for (size_t finger = 0; finger < offered.curl.fingers.size(); finger++) {
+      const auto& offered_curl = offered.curl.fingers[finger].curl;
+      const auto& decoded_curl = decoded.curl.fingers[finger].curl;
+
+      if ((channels & InputChannel_Curl) != 0 && !near(offered_curl[0], decoded_curl[0], encoder.step)) {
+        return false;
+      }
+      for (size_t joint = 1; joint < offered_curl.size() && (channels & InputChannel_CurlJoints) != 0; joint++) {
+        if (!near(offered_curl[joint], decoded_curl[joint], encoder.step)) {
+          return false;
+        }
+      }
+      if ((channels & InputChannel_Splay) != 0 && !near(offered.splay.fingers[finger], decoded.splay.fingers[finger], encoder.step)) {
+        return false;
+      }
+    }
+
+    if ((channels & InputChannel_Joystick) != 0
+        && (!near(offered.joystick.x, decoded.joystick.x, encoder.step) || !near(offered.joystick.y, decoded.joystick.y, encoder.step)
+            || offered.joystick.press != decoded.joystick.press)) {
+      return false;
+    }
+    for (size_t i = 0; i < offered.buttons.size() && (channels & InputChannel_Buttons) != 0; i++) {
+      if (offered.buttons[i].press != decoded.buttons[i].press) {
+        return false;
+      }
+    }
+    for (size_t i = 0; i < offered.analog_buttons.size() && (channels & InputChannel_AnalogButtons) != 0; i++) {
+      if (offered.analog_buttons[i].press != decoded.analog_buttons[i].press) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  auto matches(const NamedOutputEncoder& encoder, const OutputForceFeedbackData& offered, const OutputForceFeedbackData& decoded) -> bool {
+    for (size_t finger = 0; finger < offered.fingers.size(); finger++) {
+      if (!near(offered.fingers[finger], decoded.fingers[finger], encoder.step)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Frames read from a newline-delimited recording in `OPENGLOVES_BENCH_LINK_LOG`, or a synthetic hand that opens and
+  /// closes twice a second, at 1 kHz.
+  auto makeStream() -> std::vector<InputPeripheralData> {
+    std::vector<InputPeripheralData> stream;
+
+    if (const char* path = std::getenv("OPENGLOVES_BENCH_LINK_LOG")) {
+      std::ifstream log(path);
+      std::string line;
+      while (std::getline(log, line)) {
+        line += '\n';
+        const auto input = AlphaEncoding::decodeInput(reinterpret_cast<const uint8_t*>(line.data()), line.size());
+        if (const auto* peripheral = std::get_if<InputPeripheralData>(&input)) {
+          stream.push_back(*peripheral);
+        }
+      }
+      if (!stream.empty()) {
+        return stream;
+      }
+    }
+
+    for (int frame = 0; frame < 1'000; frame++) {
+      InputPeripheralData input;
+      const auto phase = static_cast<float>(frame) * 2.0F * 3.14159265F * 2.0F / 1'000.0F;
+
+      for (size_t finger = 0; finger < input.curl.fingers.size(); finger++) {
+        for (size_t joint = 0; joint < input.curl.fingers[finger].curl.size(); joint++) {
+          input.curl.fingers[finger].curl[joint] = 0.5F + 0.45F * std::sin(phase + static_cast<float>(finger + joint) * 0.3F);
+        }
+        input.splay.fingers[finger] = 0.5F + 0.1F * std::sin(phase * 0.5F + static_cast<float>(finger));
+      }
+      input.trigger.press = std::sin(phase) > 0.5F;
+      input.joystick.x = 0.5F;
+      input.joystick.y = 0.5F;
+
+      stream.push_back(input);
+    }
+    return stream;
+  }
+
+  /// Force feedback following the curls of `stream`, as a game pushing back on the fingers would.
+  auto makeOutputStream(const std::vector<InputPeripheralData>& stream) -> std::vector<OutputForceFeedbackData> {
+    std::vector<OutputForceFeedbackData> output(stream.size());
+    for (size_t frame = 0; frame < stream.size(); frame++) {
+      for (size_t finger = 0; finger < output[frame].fingers.size(); finger++) {
+        output[frame].fingers[finger] = stream[frame].curl.fingers[finger].curl_total;
+      }
+    }
+    return output;
+  }
+
+  struct Result {
+    double fps;
+    double p99;
+    double drop;
+  };
+
+  /// Offer `rate` frames per second for two seconds, and decode what comes out the other end with the matching
+  /// encoding; every delivered frame must carry the values it was sent with.
+  template<typename Encoder, typename T>
+  auto simulate(const LinkConfig& config, const Encoder& encoder, const std::vector<T>& stream, std::uint32_t rate) -> Result {
+    constexpr Timestamp DURATION = 2'000'000;
+
+    LinkSimulator link(config);
+    std::array<uint8_t, 512> buffer{};
+
+    // Frames arrive whole and in order, so the oldest one in flight is the next to be delivered
+    std::deque<size_t> in_flight;
+    size_t decoded = 0;
+    const auto decode = [&](const uint8_t* frame, size_t frame_size, std::int32_t /*latency*/) {
+      T value{};
+      if (encoder.decode(frame, frame_size, value) && matches(encoder, stream[in_flight.front()], value)) {
+        decoded++;
+      }
+      in_flight.pop_front();
+    };
+
+    const auto frames = static_cast<size_t>(DURATION / 1'000'000U * rate);
+    for (size_t frame = 0; frame < frames; frame++) {
+      const auto now = static_cast<Timestamp>(frame * 1'000'000U / rate);
+      const auto index = frame * stream.size() / frames;
+
+      const auto written = encoder.encode(stream[index], buffer.data(), static_cast<int>(buffer.size()));
+      if (link.send(now, buffer.data(), static_cast<size_t>(written))) {
+        in_flight.push_back(index);
+      }
+      link.receive(now, decode);
+    }
+    link.receive(DURATION, decode);
+    REQUIRE(decoded == link.delivered());
+
+    return {
+      static_cast<double>(link.delivered()) * 1e6 / DURATION,
+      static_cast<double>(link.latency().percentile(0.99F)) / 1'000.0,
+      100.0 * static_cast<double>(link.dropped()) / static_cast<double>(frames),
+    };
+  }
+} // namespace
+
+TEST_CASE("Evaluate LinkSimulator", "[benchmark][link]") {
+  // Offered loop rate; the saturated run at 2 kHz gives the most the link sustains, up to 2 kHz.
+  // Latencies come from `LatencyHistogram`, so the p99 is the upper bound of its power-of-two bucket
+  constexpr std::uint32_t RATE = 200;
+  constexpr std::uint32_t SATURATED = 2'000;
+
+  const auto stream = makeStream();
+  const auto output_stream = makeOutputStream(stream);
+  std::string report = "link        encoding   size  max/s  @200Hz/s  p99 ms  drop\n";
+
+  const auto row = [&report](const NamedLink& link, const auto& encoder, const auto& stream) {
+    std::array<uint8_t, 512> buffer{};
+    const auto size = encoder.encode(stream.front(), buffer.data(), static_cast<int>(buffer.size()));
+
+    const auto saturated = simulate(link.config, encoder, stream, SATURATED);
+    const auto offered = simulate(link.config, encoder, stream, RATE);
+
+    std::array<char, 128> line{};
+    std::snprintf(
+        line.data(),
+        line.size(),
+        "%-11s %-10s %4d %6.0f %9.0f %7.2f %4.0f%%\n",
+        link.name,
+        encoder.name,
+        size,
+        saturated.fps,
+        offered.fps,
+        offered.p99,
+        offered.drop
+    );
+    report += line.data();
+  };
+
+  // Each direction is simulated on its own link; full-duplex UARTs do not share the wire, BLE would share it
+  for (const auto& link : LINKS) {
+    for (const auto& encoder : ENCODERS) {
+      row(link, encoder, stream);
+    }
+    for (const auto& encoder : OUTPUT_ENCODERS) {
+      row(link, encoder, output_stream);
+    }
+  }
+
+  WARN(report);
+}
@@ -0,0 +1,64 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/pipeline.hpp>
+#include <opengloves/state_table.hpp>
+
+#include <vector>
+
+using namespace opengloves;
+
+TEST_CASE("Benchmark InputPipeline", "[benchmark][pipeline]") {
+  const auto glove_count = GENERATE(1, 16, 256);
+
+  ChannelConfig channel{};
+  channel.calibrate = true;
+  channel.deadzone = 0.05f;
+  channel.filter = FilterType_OneEuro;
+  channel.one_euro_min_cutoff = 1.0f;
+  channel.one_euro_beta = 0.1f;
+  channel.one_euro_derivative_cutoff = 1.0f;
+
+  InputPipelineConfig config{};
+  for (size_t finger = 0; finger < config.curl.fingers.size(); finger++) {
+    config.curl.fingers[finger].curl = { channel, channel, channel, channel };
+    config.splay.fingers[finger] = channel;
+  }
+  config.joystick = channel;
+
+  GloveStateTable table(glove_count);
+  std::vector<InputPeripheralData> gloves(glove_count);
+
+  InputPipeline table_pipeline(glove_count, config);
+  InputPipeline glove_pipeline(glove_count, config);
+
+  // Calibrate on a synthetic range, so the range mapping is exercised
+  table_pipeline.startCalibration();
+  glove_pipeline.startCalibration();
+  for (const auto value : { 0.1f, 0.9f }) {
+    for (int i = 0; i < glove_count; i++) {
+      auto& input = gloves[i];
+      for (auto& finger : input.curl.fingers) {
+        finger.curl = { value, value, value, value };
+      }
+      table.set(i, input);
+      glove_pipeline.process(input, 0.01f, i);
+    }
+    table_pipeline.process(table, 0.01f);
+  }
+  table_pipeline.stopCalibration();
+  glove_pipeline.stopCalibration();
+
+  // Results are reported per tick, divide by the glove count for ns per glove-frame
+  BENCHMARK("process GloveStateTable x" + std::to_string(glove_count)) {
+    table_pipeline.process(table, 0.01f);
+    return table.curl(0)[0];
+  };
+
+  BENCHMARK("process InputPeripheralData x" + std::to_string(glove_count)) {
+    for (int i = 0; i < glove_count; i++) {
+      glove_pipeline.process(gloves[i], 0.01f, i);
+    }
+    return gloves[0].curl.thumb.curl_total;
+  };
+}
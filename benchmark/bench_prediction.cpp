@@ -0,0 +1,94 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/prediction.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+using namespace opengloves;
+
+namespace {
+  /// Synthetic finger motion: a slow grab with a faster tremor on top, in [0, 1]
+  auto motion(double seconds) -> float {
+    constexpr double TWO_PI = 6.283185307179586;
+
+    return static_cast<float>(0.5 + 0.4 * std::sin(TWO_PI * 1.5 * seconds) + 0.05 * std::sin(TWO_PI * 4.3 * seconds));
+  }
+
+  auto frameAt(Timestamp timestamp) -> InputPeripheralData {
+    InputPeripheralData input;
+    const auto seconds = static_cast<double>(timestamp) / 1e6;
+
+    for (size_t finger = 0; finger < input.curl.fingers.size(); finger++) {
+      input.curl.fingers[finger].curl_total = motion(seconds + 0.05 * static_cast<double>(finger));
+    }
+    return input;
+  }
+
+  /// RMS error of the index curl, when sampling `horizon` after every received frame
+  auto evaluate(PredictionMode mode, Timestamp frame_period, Timestamp horizon) -> double {
+    InputPredictor<4> predictor({ .mode = mode });
+
+    double sum = 0.0;
+    int samples = 0;
+
+    for (Timestamp t = 0; t < 10'000'000; t += frame_period) {
+      predictor.push(t, frameAt(t));
+      if (t < 100'000) {
+        continue; // let the history fill up
+      }
+
+      const auto predicted = predictor.predict(t + horizon).curl.index.curl_total;
+      const auto expected = frameAt(t + horizon).curl.index.curl_total;
+      sum += (predicted - expected) * (predicted - expected);
+      samples++;
+    }
+
+    return std::sqrt(sum / samples);
+  }
+} // namespace
+
+TEST_CASE("Benchmark InputPredictor", "[benchmark][prediction]") {
+  InputPredictor<4> predictor;
+  Timestamp t = 0;
+  for (; t < 100'000; t += 11'111) {
+    predictor.push(t, frameAt(t));
+  }
+  const auto frame = frameAt(t);
+
+  BENCHMARK("push") {
+    t += 11'111;
+    predictor.push(t, frame);
+    return predictor.history().size();
+  };
+
+  BENCHMARK("predict") {
+    return predictor.predict(t + 8'000);
+  };
+}
+
+TEST_CASE("Evaluate InputPredictor", "[benchmark][prediction]") {
+  // RMS error of the index curl vs. the latency hidden, for 60 and 120 Hz links
+  std::string report = "frame rate, latency hidden: hold / linear / damped RMS error\n";
+
+  for (const Timestamp frame_period : { 16'667U, 8'333U }) {
+    for (const Timestamp horizon : { 0U, 5'556U, 11'111U, 16'667U, 33'333U }) {
+      std::array<char, 128> line{};
+      std::snprintf(
+        line.data(),
+        line.size(),
+        "%3u Hz, %5.1f ms: %.4f / %.4f / %.4f\n",
+        (1'000'000U + frame_period / 2) / frame_period,
+        static_cast<double>(horizon) / 1000.0,
+        evaluate(PredictionMode_Hold, frame_period, horizon),
+        evaluate(PredictionMode_Linear, frame_period, horizon),
+        evaluate(PredictionMode_VelocityDamped, frame_period, horizon)
+      );
+      report += line.data();
+    }
+  }
+
+  WARN(report);
+}
@@ -0,0 +1,62 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+#include <opengloves/receive.hpp>
+
+#include <cstring>
+#include <string>
+
+using namespace opengloves;
+
+namespace {
+  /// `frames` queued force feedback frames, every fourth one a partial update, with half a frame still incoming
+  auto makeBacklog(size_t frames) -> std::string {
+    std::string backlog;
+    std::string buffer(64, '\0');
+
+    for (size_t i = 0; i < frames; i++) {
+      const auto value = static_cast<float>(i % 64) / 63.0F;
+      OutputForceFeedbackData ffb{ .thumb = value, .index = 1.0F - value, .middle = 0.25F, .ring = 0.5F, .pinky = value };
+
+      const auto written = AlphaEncoding::encodeOutput(ffb, reinterpret_cast<uint8_t*>(buffer.data()), buffer.size());
+      backlog.append(buffer.data(), i % 4 == 3 ? 7 : static_cast<size_t>(written));
+      if (i % 4 == 3) {
+        backlog += '\n';
+      }
+    }
+
+    return backlog + "A1024B20";
+  }
+} // namespace
+
+TEST_CASE("Benchmark LatestFrameDecoder", "[benchmark][receive]") {
+  for (const size_t frames : { 1, 8, 64, 512 }) {
+    const auto backlog = makeBacklog(frames);
+    const auto* data = reinterpret_cast<const uint8_t*>(backlog.data());
+    const auto suffix = ", " + std::to_string(frames) + " frames";
+
+    // What a receiver does without the helper: decode every queued frame, in order
+    BENCHMARK("decode all" + suffix) {
+      OutputData latest;
+      for (size_t offset = 0; offset < backlog.size();) {
+        const auto* newline = static_cast<const uint8_t*>(std::memchr(data + offset, '\n', backlog.size() - offset));
+        if (newline == nullptr) {
+          break;
+        }
+        const auto end = static_cast<size_t>(newline - data) + 1;
+        latest = AlphaEncoding::decodeOutput(data + offset, end - offset);
+        offset = end;
+      }
+      return latest;
+    };
+
+    BENCHMARK("decode latest" + suffix) {
+      return LatestFrameDecoder<>::decodeOutput(data, backlog.size());
+    };
+
+    BENCHMARK("decode latest, merged" + suffix) {
+      return LatestFrameDecoder<>::decodeOutput(data, backlog.size(), true);
+    };
+  }
+}
@@ -0,0 +1,77 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+
+#include <cstdio>
+#include <string>
+
+using namespace opengloves;
+
+namespace {
+  /// Every analog channel in use, with values close to full scale, so they need all digits of every range
+  auto fullFrame() -> InputPeripheralData {
+    InputPeripheralData input;
+
+    for (size_t finger = 0; finger < input.curl.fingers.size(); finger++) {
+      for (size_t joint = 0; joint < input.curl.fingers[finger].curl.size(); joint++) {
+        input.curl.fingers[finger].curl[joint] = 0.98F + 0.005F * static_cast<float>(joint);
+      }
+      input.splay.fingers[finger] = 0.99F;
+    }
+    input.joystick = { .x = 0.985F, .y = 0.995F, .press = true };
+    input.trigger.press = true;
+
+    return input;
+  }
+
+  template<typename Encoding>
+  auto bytesPerFrame(const InputPeripheralData& input, const OutputForceFeedbackData& ffb) -> std::pair<int, int> {
+    std::string buffer(256, '\0');
+
+    return {
+      Encoding::encodeInputPeripheral(input, reinterpret_cast<uint8_t *>(buffer.data()), buffer.size()),
+      Encoding::encodeOutput(ffb, reinterpret_cast<uint8_t *>(buffer.data()), buffer.size()),
+    };
+  }
+} // namespace
+
+TEMPLATE_TEST_CASE("Benchmark AlphaEncoding resolution", "[benchmark][alpha][resolution]", AlphaEncoding8, AlphaEncoding10, AlphaEncoding12, AlphaEncoding16) {
+  const auto input = fullFrame();
+  const OutputForceFeedbackData ffb{ .thumb = 0.98F, .index = 0.985F, .middle = 0.99F, .ring = 0.995F, .pinky = 0.999F };
+  std::string buffer(256, '\0');
+
+  BENCHMARK("encode input") {
+    return TestType::encodeInputPeripheral(input, reinterpret_cast<uint8_t *>(buffer.data()), buffer.size());
+  };
+
+  BENCHMARK("encode force feedback") {
+    return TestType::encodeOutput(ffb, reinterpret_cast<uint8_t *>(buffer.data()), buffer.size());
+  };
+
+  const auto written = TestType::encodeInputPeripheral(input, reinterpret_cast<uint8_t *>(buffer.data()), buffer.size());
+  InputPeripheralData decoded;
+
+  BENCHMARK("decode input") {
+    return TestType::decodeInputPeripheral(reinterpret_cast<const uint8_t *>(buffer.data()), written, decoded);
+  };
+}
+
+TEST_CASE("Evaluate AlphaEncoding resolution", "[benchmark][alpha][resolution]") {
+  const auto input = fullFrame();
+  const OutputForceFeedbackData ffb{ .thumb = 0.98F, .index = 0.985F, .middle = 0.99F, .ring = 0.995F, .pinky = 0.999F };
+
+  std::string report = "resolution: input / force feedback bytes per frame\n";
+  const auto add = [&report](const char* name, std::pair<int, int> bytes) {
+    std::array<char, 64> line{};
+    std::snprintf(line.data(), line.size(), "%s: %3d / %2d\n", name, bytes.first, bytes.second);
+    report += line.data();
+  };
+
+  add(" 8 bit", bytesPerFrame<AlphaEncoding8>(input, ffb));
+  add("10 bit", bytesPerFrame<AlphaEncoding10>(input, ffb));
+  add("12 bit", bytesPerFrame<AlphaEncoding12>(input, ffb));
+  add("16 bit", bytesPerFrame<AlphaEncoding16>(input, ffb));
+
+  WARN(report);
+}
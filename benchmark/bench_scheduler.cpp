@@ -0,0 +1,152 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+#include <opengloves/scheduler.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+using namespace opengloves;
+
+namespace {
+  constexpr double TWO_PI = 6.283185307179586;
+
+  /// Deterministic sensor noise, about one ADC step of a 12-bit glove
+  auto noise(Timestamp t) -> float {
+    return static_cast<float>(((t / 1'000U) * 2'654'435'761U) >> 22U) / 1024.0F * 0.0005F;
+  }
+
+  auto rest(Timestamp t) -> float { return 0.3F + noise(t); }
+
+  auto slowGrab(Timestamp t) -> float {
+    return static_cast<float>(0.5 + 0.4 * std::sin(TWO_PI * 0.5 * static_cast<double>(t) / 1e6)) + noise(t);
+  }
+
+  auto fastGestures(Timestamp t) -> float {
+    return static_cast<float>(0.5 + 0.4 * std::sin(TWO_PI * 3.0 * static_cast<double>(t) / 1e6)) + noise(t);
+  }
+
+  /// Mostly at rest, with a quick grab-and-release every two seconds
+  auto mixed(Timestamp t) -> float {
+    const auto phase = static_cast<double>(t % 2'000'000U) / 1e6;
+    if (phase > 0.4) {
+      return rest(t);
+    }
+    return static_cast<float>(0.3 + 0.3 * (1.0 - std::cos(TWO_PI * phase / 0.4))) + noise(t);
+  }
+
+  auto frameAt(float (*trace)(Timestamp), Timestamp t) -> InputPeripheralData {
+    InputPeripheralData input;
+    for (size_t finger = 0; finger < input.curl.fingers.size(); finger++) {
+      input.curl.fingers[finger].curl_total = trace(t + static_cast<Timestamp>(finger) * 30'000U);
+    }
+    return input;
+  }
+
+  struct Result {
+    double frames_per_second;
+    double bytes_per_second;
+    /// Age of the newest frame on the host, averaged over every loop iteration
+    double mean_age;
+    Timestamp max_age;
+    /// Error of the index curl on the host
+    double rms_error;
+  };
+
+  /// Run a 1 kHz glove loop over 10 s of `trace`, sending either when the scheduler says so, or at a fixed rate
+  auto simulate(float (*trace)(Timestamp), bool adaptive) -> Result {
+    constexpr Timestamp DURATION = 10'000'000;
+    constexpr Timestamp FIXED_PERIOD = 5'000; // the scheduler's default max rate
+
+    FrameScheduler scheduler;
+    std::string buffer(256, '\0');
+
+    Result result{};
+    Timestamp last_sent = 0;
+    float host_value = 0.0F;
+    double age_sum = 0.0;
+    double error_sum = 0.0;
+    int frames = 0;
+    int ticks = 0;
+
+    for (Timestamp t = 0; t < DURATION; t += 1'000, ticks++) {
+      const auto input = frameAt(trace, t);
+      const auto send = adaptive ? scheduler.poll(t, input) : t % FIXED_PERIOD == 0;
+
+      if (send) {
+        result.bytes_per_second += AlphaEncoding::encodeInput(input, reinterpret_cast<uint8_t*>(buffer.data()), buffer.size());
+        host_value = input.curl.index.curl_total;
+        last_sent = t;
+        frames++;
+      }
+
+      const auto age = t - last_sent;
+      age_sum += age;
+      result.max_age = std::max(result.max_age, age);
+
+      const auto error = static_cast<double>(input.curl.index.curl_total - host_value);
+      error_sum += error * error;
+    }
+
+    const auto seconds = static_cast<double>(DURATION) / 1e6;
+    result.frames_per_second = frames / seconds;
+    result.bytes_per_second /= seconds;
+    result.mean_age = age_sum / ticks;
+    result.rms_error = std::sqrt(error_sum / ticks);
+    return result;
+  }
+} // namespace
+
+TEST_CASE("Benchmark FrameScheduler", "[benchmark][scheduler]") {
+  FrameScheduler scheduler;
+  const auto input = frameAt(fastGestures, 0);
+  Timestamp t = 0;
+
+  BENCHMARK("poll") {
+    t += 1'000;
+    return scheduler.poll(t, input);
+  };
+}
+
+TEST_CASE("Evaluate FrameScheduler", "[benchmark][scheduler]") {
+  // Adaptive scheduling vs. a fixed 200 Hz send loop; frame age is how old the host's newest frame is
+  std::string report;
+
+  const std::array<std::pair<const char*, float (*)(Timestamp)>, 4> traces = { {
+      { "rest", rest },
+      { "mixed", mixed },
+      { "slow grab", slowGrab },
+      { "fast gestures", fastGestures },
+  } };
+
+  for (const auto& [name, trace] : traces) {
+    const auto adaptive = simulate(trace, true);
+    const auto fixed = simulate(trace, false);
+
+    std::array<char, 256> line{};
+    std::snprintf(
+        line.data(),
+        line.size(),
+        "%s\n"
+        "  adaptive: %5.1f fps, %4.0f B/s (%2.0f%% saved), age %5.2f / %5.1f ms, RMS %.4f\n"
+        "  fixed:    %5.1f fps, %4.0f B/s,             age %5.2f / %5.1f ms, RMS %.4f\n",
+        name,
+        adaptive.frames_per_second,
+        adaptive.bytes_per_second,
+        100.0 * (1.0 - adaptive.bytes_per_second / fixed.bytes_per_second),
+        adaptive.mean_age / 1000.0,
+        static_cast<double>(adaptive.max_age) / 1000.0,
+        adaptive.rms_error,
+        fixed.frames_per_second,
+        fixed.bytes_per_second,
+        fixed.mean_age / 1000.0,
+        static_cast<double>(fixed.max_age) / 1000.0,
+        fixed.rms_error
+    );
+    report += line.data();
+  }
+
+  WARN(report);
+}
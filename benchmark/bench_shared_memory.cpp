@@ -0,0 +1,146 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/shared_memory.hpp>
+
+#ifdef OPENGLOVES_HAS_SHARED_MEMORY
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+
+using namespace opengloves;
+
+namespace {
+  auto segmentName() -> std::string { return "/opengloves-bench-" + std::to_string(getpid()); }
+
+  /// Ping-pong between two processes: the parent publishes glove 0, the child answers on glove 1.
+  /// \return One-way latencies (half the round trip) in nanoseconds.
+  auto pingPong(bool spin, int rounds) -> std::vector<double> {
+    const auto name = segmentName();
+    SharedGloveState state;
+    if (!state.create(name.c_str(), 2)) {
+      return {};
+    }
+
+    // Waits for the next publish on `glove`, either on the futex or by polling the sequence number
+    const auto await = [spin](SharedGloveState& shared, std::uint32_t glove, std::uint32_t& sequence, InputPeripheralData& input) {
+      while (true) {
+        const auto generation = shared.generation();
+        const auto current = shared.read(glove, input);
+        if (current != sequence) {
+          sequence = current;
+          return true;
+        }
+        if (spin) {
+          // Yield, so the other process still runs when both share a core
+          std::this_thread::yield();
+        } else if (!shared.wait(generation, 1'000'000)) {
+          return false;
+        }
+      }
+    };
+
+    const auto child = fork();
+    if (child == 0) {
+      SharedGloveState reader;
+      if (!reader.open(name.c_str())) {
+        _exit(1);
+      }
+
+      InputPeripheralData input;
+      std::uint32_t sequence = 0;
+      for (int round = 0; round < rounds; round++) {
+        if (!await(reader, 0, sequence, input)) {
+          _exit(2);
+        }
+        reader.publish(1, input);
+      }
+      _exit(0);
+    }
+
+    std::vector<double> latencies;
+    InputPeripheralData input;
+    std::uint32_t sequence = 0;
+
+    for (int round = 0; round < rounds; round++) {
+      input.curl.index.curl_total = static_cast<float>(round);
+
+      const auto start = std::chrono::steady_clock::now();
+      state.publish(0, input);
+      if (!await(state, 1, sequence, input)) {
+        break;
+      }
+      const auto round_trip = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+      latencies.push_back(round_trip / 2.0);
+    }
+
+    waitpid(child, nullptr, 0);
+    SharedGloveState::unlink(name.c_str());
+
+    std::sort(latencies.begin(), latencies.end());
+    return latencies;
+  }
+} // namespace
+
+TEST_CASE("Benchmark SharedGloveState", "[benchmark][shared_memory]") {
+  const auto name = segmentName();
+  SharedGloveState state;
+  REQUIRE(state.create(name.c_str(), 16));
+
+  InputPeripheralData input;
+  input.curl.index.curl_total = 0.5F;
+
+  BENCHMARK("publish input") {
+    state.publish(7, input);
+    return state.generation();
+  };
+
+  BENCHMARK("read input") {
+    return state.read(7, input);
+  };
+
+  OutputData output = OutputForceFeedbackData{ .thumb = 0.5F, .index = 0.5F, .middle = 0.5F, .ring = 0.5F, .pinky = 0.5F };
+
+  BENCHMARK("publish output") {
+    state.publish(7, output);
+    return state.generation();
+  };
+
+  BENCHMARK("read output") {
+    return state.read(7, output);
+  };
+
+  SharedGloveState::unlink(name.c_str());
+}
+
+TEST_CASE("Evaluate SharedGloveState", "[benchmark][shared_memory]") {
+  // One-way latency from publish to a reader in another process having the state
+  std::string report = "reader: p50 / p99 / max one-way latency, ns\n";
+
+  for (const auto spin : { false, true }) {
+    const auto latencies = pingPong(spin, 10'000);
+    REQUIRE_FALSE(latencies.empty());
+
+    std::array<char, 128> line{};
+    std::snprintf(
+        line.data(),
+        line.size(),
+        "%-7s: %7.0f / %7.0f / %7.0f\n",
+        spin ? "polling" : "futex",
+        latencies[latencies.size() / 2],
+        latencies[latencies.size() * 99 / 100],
+        latencies.back()
+    );
+    report += line.data();
+  }
+
+  WARN(report);
+}
+
+#endif
@@ -0,0 +1,67 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+#include <opengloves/state_table.hpp>
+
+#include <vector>
+
+using namespace opengloves;
+
+TEST_CASE("Benchmark GloveStateTable", "[benchmark][state_table]") {
+  const auto glove_count = GENERATE(16, 256, 1024);
+
+  std::vector<InputPeripheralData> gloves(glove_count);
+  GloveStateTable table(glove_count);
+
+  for (int i = 0; i < glove_count; i++) {
+    auto& input = gloves[i];
+    for (size_t finger = 0; finger < input.curl.fingers.size(); finger++) {
+      input.curl.fingers[finger].curl_total = static_cast<float>((i + finger) % 100) / 100.0f;
+    }
+    table.set(i, input);
+  }
+
+  std::vector<float> averages(glove_count, 0.0f);
+
+  BENCHMARK("curl average, vector<InputPeripheralData> x" + std::to_string(glove_count)) {
+    for (size_t i = 0; i < gloves.size(); i++) {
+      float sum = 0.0f;
+      for (const auto& finger : gloves[i].curl.fingers) {
+        sum += finger.curl_total;
+      }
+      averages[i] = sum / 5.0f;
+    }
+    return averages.data();
+  };
+
+  BENCHMARK("curl average, GloveStateTable x" + std::to_string(glove_count)) {
+    const auto* thumb = table.curl(0);
+    const auto* index = table.curl(1);
+    const auto* middle = table.curl(2);
+    const auto* ring = table.curl(3);
+    const auto* pinky = table.curl(4);
+    auto* output = averages.data();
+
+    for (size_t i = 0; i < table.size(); i++) {
+      output[i] = (thumb[i] + index[i] + middle[i] + ring[i] + pinky[i]) / 5.0f;
+    }
+    return output;
+  };
+
+  std::string frame = "A1023(AAB)2047(AAC)3071(AAD)4095B1023C1023D1023E1023F2047G2047JK\n";
+
+  BENCHMARK("decode fleet, vector<InputPeripheralData> x" + std::to_string(glove_count)) {
+    for (auto& glove : gloves) {
+      AlphaEncoding::decodeInputPeripheral(reinterpret_cast<uint8_t*>(frame.data()), frame.length(), glove);
+    }
+    return gloves.data();
+  };
+
+  BENCHMARK("decode fleet, GloveStateTable x" + std::to_string(glove_count)) {
+    for (size_t i = 0; i < table.size(); i++) {
+      table.decode(i, reinterpret_cast<uint8_t*>(frame.data()), frame.length());
+    }
+    return table.curl(0);
+  };
+}
@@ -0,0 +1,140 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+#include <opengloves/udp.hpp>
+
+#ifdef OPENGLOVES_HAS_UDP
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using namespace opengloves;
+
+namespace {
+  inline constexpr size_t GLOVE_COUNT = 32;
+
+  /// Give up on datagrams that did not arrive within a second, the caller checks the count.
+  inline constexpr std::uint32_t TIMEOUT = 1'000'000;
+
+  struct Loopback {
+    UdpBatchReceiver<GLOVE_COUNT> receiver;
+    UdpBatchSender<GLOVE_COUNT> sender;
+    GloveStateTable table{ GLOVE_COUNT };
+    InputPeripheralData input;
+
+    Loopback() {
+      receiver.bind("127.0.0.1", 0);
+      sender.open("127.0.0.1", receiver.socket().port());
+      input.curl.index.curl_total = 0.5F;
+      input.splay.middle = 0.25F;
+      input.joystick.x = 0.75F;
+    }
+
+    /// One frame of every glove, sent and received in one batch each.
+    auto batched() -> size_t {
+      for (std::uint16_t glove = 0; glove < GLOVE_COUNT; glove++) {
+        sender.emplace(glove, [this](uint8_t* buffer, int buffer_size) {
+          return AlphaEncoding::encodeInputPeripheral(input, buffer, buffer_size);
+        });
+      }
+      sender.flush();
+
+      size_t received = 0;
+      while (received < GLOVE_COUNT) {
+        const auto count = receiver.receive(table, TIMEOUT);
+        if (count == 0) {
+          break;
+        }
+        received += count;
+      }
+      return received;
+    }
+
+    /// One frame of every glove, with a `send`/`recv` per frame.
+    auto unbatched() -> size_t {
+      std::array<uint8_t, 256> buffer{};
+      for (std::uint16_t glove = 0; glove < GLOVE_COUNT; glove++) {
+        buffer[0] = static_cast<uint8_t>(glove >> 8U);
+        buffer[1] = static_cast<uint8_t>(glove & 0xFFU);
+        const auto written = AlphaEncoding::encodeInputPeripheral(input, buffer.data() + UDP_HEADER_SIZE, buffer.size() - UDP_HEADER_SIZE);
+        send(sender.socket().fd(), buffer.data(), UDP_HEADER_SIZE + static_cast<size_t>(written), 0);
+      }
+
+      size_t received = 0;
+      while (received < GLOVE_COUNT) {
+        pollfd descriptor{ receiver.socket().fd(), POLLIN, 0 };
+        if (poll(&descriptor, 1, static_cast<int>(TIMEOUT / 1'000U)) <= 0) {
+          break;
+        }
+
+        const auto size = recv(receiver.socket().fd(), buffer.data(), buffer.size(), MSG_DONTWAIT);
+        if (size < static_cast<ssize_t>(UDP_HEADER_SIZE)) {
+          break;
+        }
+        const auto glove = static_cast<size_t>((buffer[0] << 8U) | buffer[1]);
+        table.decode(glove, buffer.data() + UDP_HEADER_SIZE, static_cast<size_t>(size) - UDP_HEADER_SIZE);
+        received++;
+      }
+      return received;
+    }
+  };
+
+  auto cpuTime() -> double {
+    timespec time{};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+    return static_cast<double>(time.tv_sec) * 1e9 + static_cast<double>(time.tv_nsec);
+  }
+} // namespace
+
+TEST_CASE("Benchmark UDP bridge", "[benchmark][udp]") {
+  Loopback loopback;
+  REQUIRE(loopback.batched() == GLOVE_COUNT);
+  REQUIRE(loopback.unbatched() == GLOVE_COUNT);
+
+  BENCHMARK(std::to_string(GLOVE_COUNT) + " frames, sendmmsg/recvmmsg") {
+    return loopback.batched();
+  };
+
+  BENCHMARK(std::to_string(GLOVE_COUNT) + " frames, send/recv") {
+    return loopback.unbatched();
+  };
+}
+
+TEST_CASE("Evaluate UDP bridge", "[benchmark][udp]") {
+  // Throughput over loopback, encoding and decoding included, as the bridge and the host share a core here
+  constexpr int ROUNDS = 5'000;
+  Loopback loopback;
+  std::string report = "mode: frames/s, CPU ns/frame\n";
+
+  for (const auto batched : { true, false }) {
+    size_t frames = 0;
+    const auto cpu_start = cpuTime();
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int round = 0; round < ROUNDS; round++) {
+      frames += batched ? loopback.batched() : loopback.unbatched();
+    }
+
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto cpu = cpuTime() - cpu_start;
+    REQUIRE(frames == static_cast<size_t>(ROUNDS) * GLOVE_COUNT);
+
+    std::array<char, 128> line{};
+    std::snprintf(
+        line.data(),
+        line.size(),
+        "%-9s: %9.0f, %6.0f\n",
+        batched ? "batched" : "unbatched",
+        static_cast<double>(frames) / seconds,
+        cpu / static_cast<double>(frames)
+    );
+    report += line.data();
+  }
+
+  WARN(report);
+}
+
+#endif
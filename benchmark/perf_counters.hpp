@@ -0,0 +1,233 @@
+#pragma once
+
+#include <catch2/benchmark/catch_optimizer.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if __has_include(<linux/perf_event.h>)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define OPENGLOVES_HAS_PERF_EVENTS
+#endif
+
+namespace opengloves::benchmark {
+  /// Counts hardware events of the calling thread, in user space only, through `perf_event_open`.
+  ///
+  /// Counters the kernel refuses (no PMU in a VM, `perf_event_paranoid`, non-Linux) are left out, so `available()`
+  /// may be any subset of `COUNTERS`, including none of them.
+  class PerfCounters {
+    public:
+      struct Counter {
+        const char* name;
+        std::uint32_t type;
+        std::uint64_t config;
+      };
+
+      inline static constexpr const size_t COUNTER_COUNT = 5;
+
+#ifdef OPENGLOVES_HAS_PERF_EVENTS
+      inline static constexpr const std::array<Counter, COUNTER_COUNT> COUNTERS{ {
+        { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+        { "branches", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS },
+        { "branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+        { "cache-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+        // Software event, so there is something to compare when the hardware ones are missing
+        { "task-clock-ns", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK },
+      } };
+#endif
+
+      PerfCounters();
+      ~PerfCounters();
+
+      PerfCounters(const PerfCounters&) = delete;
+      auto operator=(const PerfCounters&) -> PerfCounters& = delete;
+
+      /// Names of the counters that could be opened, in the order of `stop`.
+      [[nodiscard]] auto available() const -> const std::vector<std::string>& { return this->names_; }
+
+      auto start() -> void;
+
+      /// Stop counting, and store the count of every available counter since `start()`.
+      auto stop(std::vector<double>& counts) -> void;
+
+    private:
+      std::vector<int> fds_;
+      std::vector<std::string> names_;
+  };
+
+#ifdef OPENGLOVES_HAS_PERF_EVENTS
+  inline PerfCounters::PerfCounters() {
+    for (const auto& counter : COUNTERS) {
+      perf_event_attr attr{};
+      attr.size = sizeof(attr);
+      attr.type = counter.type;
+      attr.config = counter.config;
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+      const auto fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0)); // NOLINT(*-vararg)
+      if (fd >= 0) {
+        this->fds_.push_back(fd);
+        this->names_.emplace_back(counter.name);
+      }
+    }
+  }
+
+  inline PerfCounters::~PerfCounters() {
+    for (const auto fd : this->fds_) {
+      close(fd);
+    }
+  }
+
+  inline auto PerfCounters::start() -> void {
+    for (const auto fd : this->fds_) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0); // NOLINT(*-vararg)
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0); // NOLINT(*-vararg)
+    }
+  }
+
+  inline auto PerfCounters::stop(std::vector<double>& counts) -> void {
+    for (const auto fd : this->fds_) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0); // NOLINT(*-vararg)
+    }
+
+    counts.clear();
+    for (const auto fd : this->fds_) {
+      std::array<std::uint64_t, 3> value{}; // count, time enabled, time running
+      if (::read(fd, value.data(), sizeof(value)) != static_cast<ssize_t>(sizeof(value)) || value[2] == 0) {
+        counts.push_back(NAN);
+        continue;
+      }
+
+      // Scale up if the kernel multiplexed the counter with others
+      counts.push_back(static_cast<double>(value[0]) * static_cast<double>(value[1]) / static_cast<double>(value[2]));
+    }
+  }
+#else
+  inline PerfCounters::PerfCounters() = default;
+  inline PerfCounters::~PerfCounters() = default;
+  inline auto PerfCounters::start() -> void {}
+  inline auto PerfCounters::stop(std::vector<double>& counts) -> void { counts.clear(); }
+#endif
+
+  /// Per-call counter statistics of a set of measured functions, written as the `TestCase`/`BenchmarkResults`
+  /// XML of Catch2's reporter, so `.github/scripts/compare-benchmarks.py` diffs it like the timing report.
+  class PerfCounterReport {
+    public:
+      explicit PerfCounterReport(std::string test_case) : test_case_(std::move(test_case)) {}
+
+      /// Count `fn()`, called `calls` times per sample, and record the mean and standard deviation per call.
+      template<typename Fn>
+      auto measure(PerfCounters& counters, const std::string& name, size_t samples, size_t calls, Fn&& fn) -> void;
+
+      /// Human-readable table, one row per measured function.
+      [[nodiscard]] auto table(const PerfCounters& counters) const -> std::string;
+
+      /// Write the results to the XML file `path`, replacing it.
+      auto write(const char* path) const -> bool;
+
+    private:
+      struct Result {
+        std::string name;
+        std::string counter;
+        double mean;
+        double standard_deviation;
+      };
+
+      std::string test_case_;
+      std::vector<Result> results_;
+  };
+
+  template<typename Fn>
+  inline auto PerfCounterReport::measure(PerfCounters& counters, const std::string& name, size_t samples, size_t calls, Fn&& fn) -> void {
+    const auto& names = counters.available();
+    std::vector<std::vector<double>> per_call(names.size());
+    std::vector<double> counts;
+
+    // One warm-up sample, so the caches and branch predictors are in their steady state
+    for (size_t sample = 0; sample <= samples; sample++) {
+      counters.start();
+      for (size_t call = 0; call < calls; call++) {
+        auto result = fn();
+        Catch::Benchmark::keep_memory(&result); // Keep the result, and the call, alive
+      }
+      counters.stop(counts);
+
+      for (size_t i = 0; sample > 0 && i < counts.size(); i++) {
+        per_call[i].push_back(counts[i] / static_cast<double>(calls));
+      }
+    }
+
+    for (size_t i = 0; i < names.size(); i++) {
+      double mean = 0.0;
+      for (const auto value : per_call[i]) {
+        mean += value;
+      }
+      mean /= static_cast<double>(per_call[i].size());
+
+      double variance = 0.0;
+      for (const auto value : per_call[i]) {
+        variance += (value - mean) * (value - mean);
+      }
+      variance /= static_cast<double>(per_call[i].size());
+
+      this->results_.push_back({ name, names[i], mean, std::sqrt(variance) });
+    }
+  }
+
+  inline auto PerfCounterReport::table(const PerfCounters& counters) const -> std::string {
+    std::string table = "per call:";
+    for (const auto& counter : counters.available()) {
+      table += " " + counter;
+    }
+
+    const std::string* row = nullptr;
+    for (const auto& result : this->results_) {
+      if (row == nullptr || *row != result.name) {
+        row = &result.name;
+        table += "\n" + result.name + ":";
+      }
+
+      std::array<char, 32> cell{};
+      std::snprintf(cell.data(), cell.size(), " %.1f", result.mean);
+      table += cell.data();
+    }
+
+    return table + "\n";
+  }
+
+  inline auto PerfCounterReport::write(const char* path) const -> bool {
+    FILE* file = std::fopen(path, "w");
+    if (file == nullptr) {
+      return false;
+    }
+
+    std::fprintf(file, "<Counters>\n  <TestCase name=\"%s\">\n", this->test_case_.c_str());
+    for (const auto& result : this->results_) {
+      std::fprintf(
+          file,
+          "    <BenchmarkResults name=\"%s/%s\" unit=\"/call\">\n"
+          "      <mean value=\"%.3f\"/>\n"
+          "      <standardDeviation value=\"%.3f\"/>\n"
+          "    </BenchmarkResults>\n",
+          result.name.c_str(),
+          result.counter.c_str(),
+          result.mean,
+          result.standard_deviation
+      );
+    }
+    std::fprintf(file, "  </TestCase>\n</Counters>\n");
+
+    return std::fclose(file) == 0;
+  }
+} // namespace opengloves::benchmark
@@ -2,6 +2,7 @@
 
 #include <opengloves.hpp>
 #include <opengloves/alpha.hpp>
+#include <opengloves/scheduler.hpp>
 
 #define FINGER_THUMB_PIN 32
 #define FINGER_INDEX_PIN 35
@@ -20,6 +21,9 @@ void setup() {
 InputPeripheralData input;
 std::string buffer(256, '\0');
 
+// Send at up to 200 Hz while moving, and a 10 Hz keep-alive at rest
+FrameScheduler scheduler;
+
 void loop() {
   input.curl.thumb.curl_total = analogRead(FINGER_THUMB_PIN) / ANALOG_MAX;
   input.curl.index.curl_total = analogRead(FINGER_INDEX_PIN) / ANALOG_MAX;
@@ -27,6 +31,10 @@ void loop() {
   input.curl.ring.curl_total = analogRead(FINGER_RING_PIN) / ANALOG_MAX;
   input.curl.pinky.curl_total = analogRead(FINGER_PINKY_PIN) / ANALOG_MAX;
 
+  if (!scheduler.poll(micros(), input)) {
+    return;
+  }
+
   auto const length = AlphaEncoding::encodeInput(input, reinterpret_cast<uint8_t *>(buffer.data()), buffer.size());
 
   Serial.write(buffer.data(), length);
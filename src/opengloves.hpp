@@ -1,16 +1,41 @@
 #pragma once
 
 #include <array>
+#include <optional>
 #include <variant>
 #include <cstdint>
 
 namespace opengloves {
+    /// Timestamp in microseconds.
+    ///
+    /// It is expected to wrap around (e.g. Arduino's `micros()`), so always compare timestamps with `elapsed()`.
+    using Timestamp = std::uint32_t;
+
+    /// Signed time from `from` to `to` in microseconds, correct across a wrap-around.
+    inline constexpr auto elapsed(Timestamp from, Timestamp to) -> std::int32_t
+    {
+        return static_cast<std::int32_t>(to - from);
+    }
+
     using HandIndex = std::uint8_t;
     enum Hand : HandIndex {
         Hand_Left,
         Hand_Right,
     };
 
+    using InputChannelMask = std::uint16_t;
+    /// Groups of input channels, used to negotiate which of them are sent.
+    enum InputChannel : InputChannelMask {
+        InputChannel_Curl = 1U << 0U,
+        InputChannel_CurlJoints = 1U << 1U,
+        InputChannel_Splay = 1U << 2U,
+        InputChannel_Joystick = 1U << 3U,
+        InputChannel_Buttons = 1U << 4U,
+        InputChannel_AnalogButtons = 1U << 5U,
+
+        InputChannel_All = (1U << 6U) - 1U,
+    };
+
     using DeviceTypeIndex = std::uint8_t;
     enum DeviceType : DeviceTypeIndex {
         DeviceType_LucidGloves = 0,
@@ -164,6 +189,12 @@ namespace opengloves {
         DeviceType device_type;
 
         unsigned int firmware_version;
+
+        /// Channels the device can send, `0` if not advertised.
+        InputChannelMask channels = 0;
+
+        /// Highest frame rate the device can send, in Hz, `0` if not advertised.
+        std::uint16_t max_rate = 0;
     };
 
     struct InputInvalid {
@@ -190,10 +221,44 @@ namespace opengloves {
     };
     using OutputHapticsData = OutputHaptics<float, bool>;
 
+    /// Host request for the input stream, narrowing down what the device advertised in `InputInfoData`.
+    struct OutputSubscriptionData {
+        InputChannelMask channels;
+
+        /// Target frame rate in Hz, `0` for as fast as the device goes.
+        std::uint16_t rate;
+
+        /// Bits per analog value, `0` for the protocol default.
+        std::uint8_t resolution;
+
+        auto operator==(const OutputSubscriptionData& other) const -> bool
+        {
+            return channels == other.channels && rate == other.rate && resolution == other.resolution;
+        }
+    };
+
     class OutputInvalid {
       public:
         auto operator==(const OutputInvalid& /*unused*/) const -> bool { return true; }
     };
-    using OutputData = std::variant<OutputInvalid, OutputForceFeedbackData, OutputHapticsData>;
+    using OutputData = std::variant<OutputInvalid, OutputForceFeedbackData, OutputHapticsData, OutputSubscriptionData>;
+
+    /// Optional instrumentation that can be attached to a frame in either direction.
+    struct FrameMetadata {
+        /// Incremented by the sender for every frame, used to detect loss and reordering.
+        std::optional<std::uint32_t> sequence;
+
+        /// Sender clock at the time the frame was encoded.
+        std::optional<Timestamp> timestamp;
+
+        /// The newest `timestamp` the sender has received from its peer, used to measure round-trip time.
+        std::optional<Timestamp> echo_timestamp;
+
+        auto operator==(const FrameMetadata& other) const -> bool
+        {
+            return sequence == other.sequence && timestamp == other.timestamp
+                   && echo_timestamp == other.echo_timestamp;
+        }
+    };
 
 }
\ No newline at end of file
@@ -2,12 +2,24 @@
 
 #include <opengloves.hpp>
 
+#include <algorithm>
+#include <cstdio>
 #include <map>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <variant>
 
 namespace opengloves {
-  class AlphaEncoding {
-    inline static constexpr const uint16_t MAX_ANALOG_VALUE = 4095;
+  /// Text encoding of the OpenGloves protocol.
+  ///
+  /// Analog values are sent as integers in `[0, MaxAnalogValue]`; both ends of a link must agree on the range.
+  /// Smaller ranges need fewer digits per value, larger ones keep the precision of high-resolution sensors.
+  template<std::uint16_t MaxAnalogValue>
+  class BasicAlphaEncoding {
+    static_assert(MaxAnalogValue > 0, "Analog values need a non-empty range");
+
+    inline static constexpr const uint16_t MAX_ANALOG_VALUE = MaxAnalogValue;
 
     /// Alpha keys for fingers.
     /// <b>MUST</b> be in the same order as the `InputFingerData` struct.
@@ -40,49 +52,145 @@ namespace opengloves {
     inline static constexpr const char* INFO_DEVICE_TYPE_KEY = "(ZG)";
     inline static constexpr const char* INFO_HAND_KEY = "(ZH)";
 
+    /// Negotiation keys, shared by the advertisement in the info frame and the subscription of the host.
+    inline static constexpr const char* NEGOTIATION_CHANNELS_KEY = "(ZC)";
+    inline static constexpr const char* NEGOTIATION_RATE_KEY = "(ZF)";
+    inline static constexpr const char* NEGOTIATION_RESOLUTION_KEY = "(ZP)";
+
+    /// Widest analog value a subscription can ask for, in bits.
+    inline static constexpr const std::uint8_t MAX_RESOLUTION = 16;
+
+    /// Metadata keys, decoders that do not know them skip them as unknown keys.
+    inline static constexpr const char* METADATA_SEQUENCE_KEY = "(ZQ)";
+    inline static constexpr const char* METADATA_TIMESTAMP_KEY = "(ZT)";
+    inline static constexpr const char* METADATA_ECHO_TIMESTAMP_KEY = "(ZR)";
+
     public:
       static auto encodeInput(const InputData& input, uint8_t* buffer, int buffer_size) -> int;
+      static auto encodeInput(const InputData& input, const FrameMetadata& metadata, uint8_t* buffer, int buffer_size) -> int;
       static auto encodeInputInfo(const InputInfoData& input, uint8_t* buffer, int buffer_size) -> int;
       static auto encodeInputPeripheral(const InputPeripheralData& input, uint8_t* buffer, int buffer_size) -> int;
 
+      /// Encode only the channels in `subscription.channels`, scaled to `subscription.resolution` bits.
+      static auto encodeInputPeripheral(
+          const InputPeripheralData& input, const OutputSubscriptionData& subscription, uint8_t* buffer, int buffer_size
+      ) -> int;
+
       static auto encodeOutput(const OutputData& output, uint8_t* buffer, int buffer_size) -> int;
+      static auto encodeOutput(const OutputData& output, const FrameMetadata& metadata, uint8_t* buffer, int buffer_size) -> int;
       static auto encodeOutputForceFeedback(const OutputForceFeedbackData& output, uint8_t* buffer, int buffer_size) -> int;
       static auto encodeOutputHaptics(const OutputHapticsData& output, uint8_t* buffer, int buffer_size) -> int;
+      static auto encodeOutputSubscription(const OutputSubscriptionData& output, uint8_t* buffer, int buffer_size) -> int;
+
+      /// Encode the metadata keys only, without a line break. It is meant to prefix a frame.
+      static auto encodeMetadata(const FrameMetadata& metadata, uint8_t* buffer, int buffer_size) -> int;
+
+      /// \param resolution Bits per analog value the frames were encoded with, `0` for the default.
+      static auto decodeInput(const uint8_t* buffer, size_t buffer_size, std::uint8_t resolution = 0) -> InputData;
+
+      /// Decode a peripheral frame into `input`, resetting every channel that is missing from the frame.
+      /// Works with both value (`InputPeripheralData`) and pointer (`InputPeripheral<float*, bool*>`) layouts,
+      /// so callers can decode straight into external storage.
+      ///
+      /// \return `true` if at least one peripheral key was found.
+      template<typename Tf, typename Tb>
+      static auto decodeInputPeripheral(
+          const uint8_t* buffer, size_t buffer_size, InputPeripheral<Tf, Tb>& input, std::uint8_t resolution = 0
+      ) -> bool;
 
       static auto decodeOutput(const uint8_t* buffer, size_t buffer_size) -> OutputData;
 
+      static auto decodeMetadata(const uint8_t* buffer, size_t buffer_size) -> FrameMetadata;
+
       static auto splitPairs(const char* buffer, size_t buffer_size, std::map<std::string, std::string>& pairs) -> void;
+
+      /// Allocation-free variant of `splitPairs`.
+      /// Calls `fn(key, value)` for every key of the first frame in the buffer, `value` is empty for keys without one.
+      template<typename Fn>
+      static auto forEachPair(const char* buffer, size_t buffer_size, Fn&& fn) -> void;
+
+      /// Largest encoded analog value for `resolution` bits, `0` being `MaxAnalogValue`.
+      static auto maxAnalogValue(std::uint8_t resolution) -> float;
+
+    private:
+      static auto parseUnsigned(std::string_view value) -> unsigned long;
+
+      template<typename T, typename V>
+      static auto store(T& target, V value) -> void;
   };
 
-  inline auto AlphaEncoding::encodeInput(const InputData &input, uint8_t *buffer, int buffer_size) -> int {
+  template<std::uint16_t MaxAnalogValue>
+  inline auto BasicAlphaEncoding<MaxAnalogValue>::encodeInput(const InputData &input, uint8_t *buffer, int buffer_size) -> int {
     if (std::holds_alternative<InputPeripheralData>(input)) {
-      return AlphaEncoding::encodeInputPeripheral(std::get<InputPeripheralData>(input), buffer, buffer_size);
+      return BasicAlphaEncoding::encodeInputPeripheral(std::get<InputPeripheralData>(input), buffer, buffer_size);
     } else if (std::holds_alternative<InputInfoData>(input)) {
-      return AlphaEncoding::encodeInputInfo(std::get<InputInfoData>(input), buffer, buffer_size);
+      return BasicAlphaEncoding::encodeInputInfo(std::get<InputInfoData>(input), buffer, buffer_size);
     }
 
     return 0;
   }
 
-  inline auto AlphaEncoding::encodeInputInfo(const InputInfoData &input, uint8_t *buffer, int buffer_size) -> int {
-    const auto& keyFirmwareVersion = AlphaEncoding::INFO_FIRMWARE_VERSION_KEY;
-    const auto& keyDeviceType = AlphaEncoding::INFO_DEVICE_TYPE_KEY;
-    const auto& keyHand = AlphaEncoding::INFO_HAND_KEY;
+  template<std::uint16_t MaxAnalogValue>
+  inline auto BasicAlphaEncoding<MaxAnalogValue>::encodeInput(const InputData &input, const FrameMetadata &metadata, uint8_t *buffer, int buffer_size) -> int {
+    const auto written = BasicAlphaEncoding::encodeMetadata(metadata, buffer, buffer_size);
+
+    const auto n = BasicAlphaEncoding::encodeInput(input, buffer + written, buffer_size - written);
+    if (n <= 0) {
+      return 0;
+    }
+
+    return written + n;
+  }
+
+  template<std::uint16_t MaxAnalogValue>
+  inline auto BasicAlphaEncoding<MaxAnalogValue>::encodeInputInfo(const InputInfoData &input, uint8_t *buffer, int buffer_size) -> int {
+    const auto& keyFirmwareVersion = BasicAlphaEncoding::INFO_FIRMWARE_VERSION_KEY;
+    const auto& keyDeviceType = BasicAlphaEncoding::INFO_DEVICE_TYPE_KEY;
+    const auto& keyHand = BasicAlphaEncoding::INFO_HAND_KEY;
+
+    if (input.channels == 0 && input.max_rate == 0) {
+      return snprintf(
+          reinterpret_cast<char*>(buffer),
+          buffer_size,
+          "%s%u%s%u%s%u\n",
+          keyFirmwareVersion,
+          input.firmware_version,
+          keyDeviceType,
+          input.device_type,
+          keyHand,
+          input.hand
+      );
+    }
 
+    // Older hosts skip the negotiation keys, and keep streaming everything
     return snprintf(
         reinterpret_cast<char*>(buffer),
         buffer_size,
-        "%s%u%s%u%s%u\n",
+        "%s%u%s%u%s%u%s%u%s%u\n",
         keyFirmwareVersion,
         input.firmware_version,
         keyDeviceType,
         input.device_type,
         keyHand,
-        input.hand
+        input.hand,
+        BasicAlphaEncoding::NEGOTIATION_CHANNELS_KEY,
+        static_cast<unsigned int>(input.channels),
+        BasicAlphaEncoding::NEGOTIATION_RATE_KEY,
+        static_cast<unsigned int>(input.max_rate)
     );
   }
 
-  inline auto AlphaEncoding::encodeInputPeripheral(const InputPeripheralData &input, uint8_t *buffer, int buffer_size) -> int {
+  template<std::uint16_t MaxAnalogValue>
+  inline auto BasicAlphaEncoding<MaxAnalogValue>::encodeInputPeripheral(const InputPeripheralData &input, uint8_t *buffer, int buffer_size) -> int {
+    return BasicAlphaEncoding::encodeInputPeripheral(input, OutputSubscriptionData{ InputChannel_All, 0, 0 }, buffer, buffer_size);
+  }
+
+  template<std::uint16_t MaxAnalogValue>
+  inline auto BasicAlphaEncoding<MaxAnalogValue>::encodeInputPeripheral(
+      const InputPeripheralData &input, const OutputSubscriptionData &subscription, uint8_t *buffer, int buffer_size
+  ) -> int {
+    const auto channels = subscription.channels;
+    const auto max_value = BasicAlphaEncoding::maxAnalogValue(subscription.resolution);
     auto written = 0;
 
     const auto& curls = input.curl.fingers;
@@ -93,25 +201,28 @@ namespace opengloves {
       const auto &finger_splay = splays[i];
       const char finger_alpha_key = 'A' + static_cast<char>(i);
 
-      int n = snprintf(
-        reinterpret_cast<char*>(buffer + written),
-        buffer_size - written,
-        "%c%u",
-        finger_alpha_key,
-        static_cast<int>(finger_curl.curl_total * MAX_ANALOG_VALUE)
-      );
-      if (n < 0 || n >= buffer_size - written) {
-        return written;
+      int n = 0;
+      if ((channels & InputChannel_Curl) != 0) {
+        n = snprintf(
+          reinterpret_cast<char*>(buffer + written),
+          buffer_size - written,
+          "%c%u",
+          finger_alpha_key,
+          static_cast<int>(finger_curl.curl_total * max_value)
+        );
+        if (n < 0 || n >= buffer_size - written) {
+          return written;
+        }
+        written += n;
       }
-      written += n;
 
-      if (finger_splay > 0.0F) {
+      if ((channels & InputChannel_Splay) != 0 && finger_splay > 0.0F) {
         n = snprintf(
             reinterpret_cast<char*>(buffer + written),
             buffer_size - written,
             "(%cB)%u",
             finger_alpha_key,
-            static_cast<int>(finger_splay * MAX_ANALOG_VALUE)
+            static_cast<int>(finger_splay * max_value)
         );
         if (n < 0 || n >= buffer_size - written) {
           return written;
@@ -119,6 +230,10 @@ namespace opengloves {
         written += n;
       }
 
+      if ((channels & InputChannel_CurlJoints) == 0) {
+        continue;
+      }
+
       const auto& joints = finger_curl.curl;
       for (size_t j = 1; j < joints.size(); j++) {
         const auto& joint = joints[j];
@@ -134,7 +249,7 @@ namespace opengloves {
             "(%cA%c)%u",
             finger_alpha_key,
             joint_alpha_key,
-            static_cast<int>(joint * MAX_ANALOG_VALUE)
+            static_cast<int>(joint * max_value)
         );
         if (n < 0 || n >= buffer_size - written) {
           return written;
@@ -143,31 +258,32 @@ namespace opengloves {
       }
     }
 
-    if (input.joystick.x != 0.0F) {
+    const bool joystick = (channels & InputChannel_Joystick) != 0;
+    if (joystick && input.joystick.x != 0.0F) {
       int n = snprintf(
           reinterpret_cast<char*>(buffer + written),
           buffer_size - written,
           "F%u",
-          static_cast<int>(input.joystick.x * MAX_ANALOG_VALUE)
+          static_cast<int>(input.joystick.x * max_value)
         );
       if (n < 0 || n >= buffer_size - written) {
         return written;
       }
       written += n;
     }
-    if (input.joystick.y != 0.0F) {
+    if (joystick && input.joystick.y != 0.0F) {
       int n = snprintf(
           reinterpret_cast<char*>(buffer + written),
           buffer_size - written,
           "G%u",
-          static_cast<int>(input.joystick.y * MAX_ANALOG_VALUE)
+          static_cast<int>(input.joystick.y * max_value)
       );
       if (n < 0 || n >= buffer_size - written) {
         return written;
       }
       written += n;
     }
-    if (input.joystick.press) {
+    if (joystick && input.joystick.press) {
       int n = snprintf(
           reinterpret_cast<char*>(buffer + written),
           buffer_size - written,
@@ -180,10 +296,10 @@ namespace opengloves {
     }
 
     const auto& buttons = input.buttons;
-    for (size_t i = 0; i < buttons.size(); i++) {
+    for (size_t i = 0; i < buttons.size() && (channels & InputChannel_Buttons) != 0; i++) {
       const auto& button = buttons[i];
       if (button.press) {
-        const auto& buttonKey = AlphaEncoding::BUTTON_ALPHA_KEY[i];
+        const auto& buttonKey = BasicAlphaEncoding::BUTTON_ALPHA_KEY[i];
         int n = snprintf(
             reinterpret_cast<char*>(buffer + written),
             buffer_size - written,
@@ -199,10 +315,10 @@ namespace opengloves {
     }
 
     const auto& analog_buttons = input.analog_buttons;
-    for (size_t i = 0; i < analog_buttons.size(); i++) {
+    for (size_t i = 0; i < analog_buttons.size() && (channels & InputChannel_AnalogButtons) != 0; i++) {
       const auto& button = analog_buttons[i];
       if (button.press) {
-        const auto& buttonKey = AlphaEncoding::ANALOG_BUTTON_ALPHA_KEY[i];
+        const auto& buttonKey = BasicAlphaEncoding::ANALOG_BUTTON_ALPHA_KEY[i];
         int n = snprintf(
             reinterpret_cast<char*>(buffer + written),
             buffer_size - written,
@@ -229,17 +345,65 @@ namespace opengloves {
     return written;
   }
 
-  inline auto AlphaEncoding::encodeOutput(const OutputData &output, uint8_t *buffer, int buffer_size) -> int {
+  template<std::uint16_t MaxAnalogValue>
+  inline auto BasicAlphaEncoding<MaxAnalogValue>::encodeOutput(const OutputData &output, uint8_t *buffer, int buffer_size) -> int {
     if (std::holds_alternative<OutputForceFeedbackData>(output)) {
-      return AlphaEncoding::encodeOutputForceFeedback(std::get<OutputForceFeedbackData>(output), buffer, buffer_size);
+      return BasicAlphaEncoding::encodeOutputForceFeedback(std::get<OutputForceFeedbackData>(output), buffer, buffer_size);
     } else if (std::holds_alternative<OutputHapticsData>(output)) {
-      return AlphaEncoding::encodeOutputHaptics(std::get<OutputHapticsData>(output), buffer, buffer_size);
+      return BasicAlphaEncoding::encodeOutputHaptics(std::get<OutputHapticsData>(output), buffer, buffer_size);
+    } else if (std::holds_alternative<OutputSubscriptionData>(output)) {
+      return BasicAlphaEncoding::encodeOutputSubscription(std::get<OutputSubscriptionData>(output), buffer, buffer_size);
     }
 
     return 0;
   }
 
-  inline auto AlphaEncoding::encodeOutputForceFeedback(const OutputForceFeedbackData &output, uint8_t *buffer, int buffer_size) -> int {
+  template<std::uint16_t MaxAnalogValue>
+  inline auto BasicAlphaEncoding<MaxAnalogValue>::encodeOutput(const OutputData &output, const FrameMetadata &metadata, uint8_t *buffer, int buffer_size) -> int {
+    const auto written = BasicAlphaEncoding::encodeMetadata(metadata, buffer, buffer_size);
+
+    const auto n = BasicAlphaEncoding::encodeOutput(output, buffer + written, buffer_size - written);
+    if (n <= 0) {
+      return 0;
+    }
+
+    return written + n;
+  }
+
+  template<std::uint16_t MaxAnalogValue>
+  inline auto BasicAlphaEncoding<MaxAnalogValue>::encodeMetadata(const FrameMetadata &metadata, uint8_t *buffer, int buffer_size) -> int {
+    const std::array<std::pair<const char*, const std::optional<std::uint32_t>*>, 3> fields = { {
+        { BasicAlphaEncoding::METADATA_SEQUENCE_KEY, &metadata.sequence },
+        { BasicAlphaEncoding::METADATA_TIMESTAMP_KEY, &metadata.timestamp },
+        { BasicAlphaEncoding::METADATA_ECHO_TIMESTAMP_KEY, &metadata.echo_timestamp },
+    } };
+
+    auto written = 0;
+
+    for (const auto& [key, value] : fields) {
+      if (!value->has_value()) {
+        continue;
+      }
+
+      int n = snprintf(
+          reinterpret_cast<char*>(buffer + written),
+          buffer_size - written,
+          "%s%lu",
+          key,
+          static_cast<unsigned long>(**value)
+      );
+      if (n < 0 || n >= buffer_size - written) {
+        // Never leave a truncated key behind, the frame is still valid without metadata
+        return written;
+      }
+      written += n;
+    }
+
+    return written;
+  }
+
+  template<std::uint16_t MaxAnalogValue>
+  inline auto BasicAlphaEncoding<MaxAnalogValue>::encodeOutputForceFeedback(const OutputForceFeedbackData &output, uint8_t *buffer, int buffer_size) -> int {
     return snprintf(
         reinterpret_cast<char*>(buffer),
         buffer_size,
@@ -252,7 +416,8 @@ namespace opengloves {
     );
   }
 
-  inline auto AlphaEncoding::encodeOutputHaptics(const opengloves::OutputHapticsData &output, uint8_t *buffer, int buffer_size) -> int {
+  template<std::uint16_t MaxAnalogValue>
+  inline auto BasicAlphaEncoding<MaxAnalogValue>::encodeOutputHaptics(const opengloves::OutputHapticsData &output, uint8_t *buffer, int buffer_size) -> int {
     return snprintf(
         reinterpret_cast<char*>(buffer),
         buffer_size,
@@ -263,13 +428,165 @@ namespace opengloves {
     );
   }
 
-  inline auto AlphaEncoding::decodeOutput(const uint8_t *buffer, size_t buffer_size) -> OutputData {
+  template<std::uint16_t MaxAnalogValue>
+  inline auto BasicAlphaEncoding<MaxAnalogValue>::encodeOutputSubscription(const OutputSubscriptionData &output, uint8_t *buffer, int buffer_size) -> int {
+    return snprintf(
+        reinterpret_cast<char*>(buffer),
+        buffer_size,
+        "%s%u%s%u%s%u\n",
+        BasicAlphaEncoding::NEGOTIATION_CHANNELS_KEY,
+        static_cast<unsigned int>(output.channels),
+        BasicAlphaEncoding::NEGOTIATION_RATE_KEY,
+        static_cast<unsigned int>(output.rate),
+        BasicAlphaEncoding::NEGOTIATION_RESOLUTION_KEY,
+        static_cast<unsigned int>(output.resolution)
+    );
+  }
+
+  template<std::uint16_t MaxAnalogValue>
+  inline auto BasicAlphaEncoding<MaxAnalogValue>::decodeInput(const uint8_t *buffer, size_t buffer_size, std::uint8_t resolution) -> InputData {
+    InputInfoData info{};
+    bool has_info = false;
+
+    BasicAlphaEncoding::forEachPair(reinterpret_cast<const char*>(buffer), buffer_size, [&](std::string_view key, std::string_view value) {
+      if (key == BasicAlphaEncoding::INFO_FIRMWARE_VERSION_KEY) {
+        info.firmware_version = static_cast<unsigned int>(BasicAlphaEncoding::parseUnsigned(value));
+        has_info = true;
+      } else if (key == BasicAlphaEncoding::INFO_DEVICE_TYPE_KEY) {
+        info.device_type = static_cast<DeviceType>(BasicAlphaEncoding::parseUnsigned(value));
+        has_info = true;
+      } else if (key == BasicAlphaEncoding::INFO_HAND_KEY) {
+        info.hand = static_cast<Hand>(BasicAlphaEncoding::parseUnsigned(value));
+        has_info = true;
+      } else if (key == BasicAlphaEncoding::NEGOTIATION_CHANNELS_KEY) {
+        info.channels = static_cast<InputChannelMask>(BasicAlphaEncoding::parseUnsigned(value));
+      } else if (key == BasicAlphaEncoding::NEGOTIATION_RATE_KEY) {
+        info.max_rate = static_cast<std::uint16_t>(BasicAlphaEncoding::parseUnsigned(value));
+      }
+    });
+
+    if (has_info) {
+      return info;
+    }
+
+    InputPeripheralData peripheral;
+    if (BasicAlphaEncoding::decodeInputPeripheral(buffer, buffer_size, peripheral, resolution)) {
+      return peripheral;
+    }
+
+    return InputInvalid{};
+  }
+
+  template<std::uint16_t MaxAnalogValue>
+  template<typename Tf, typename Tb>
+  inline auto BasicAlphaEncoding<MaxAnalogValue>::decodeInputPeripheral(
+      const uint8_t *buffer, size_t buffer_size, InputPeripheral<Tf, Tb> &input, std::uint8_t resolution
+  ) -> bool {
+    // Encoder omits zero values and released buttons, so every frame is a full snapshot
+    for (auto& finger : input.curl.fingers) {
+      for (auto& joint : finger.curl) {
+        BasicAlphaEncoding::store(joint, 0.0F);
+      }
+    }
+    for (auto& splay : input.splay.fingers) {
+      BasicAlphaEncoding::store(splay, 0.0F);
+    }
+    BasicAlphaEncoding::store(input.joystick.x, 0.0F);
+    BasicAlphaEncoding::store(input.joystick.y, 0.0F);
+    BasicAlphaEncoding::store(input.joystick.press, false);
+    for (auto& button : input.buttons) {
+      BasicAlphaEncoding::store(button.press, false);
+    }
+    for (auto& button : input.analog_buttons) {
+      BasicAlphaEncoding::store(button.press, false);
+      BasicAlphaEncoding::store(button.value, 0.0F);
+    }
+
+    bool found = false;
+    const auto max_value = BasicAlphaEncoding::maxAnalogValue(resolution);
+
+    BasicAlphaEncoding::forEachPair(reinterpret_cast<const char*>(buffer), buffer_size, [&](std::string_view key, std::string_view value) {
+      const auto analog = static_cast<float>(BasicAlphaEncoding::parseUnsigned(value)) / max_value;
+
+      if (key.size() == 1) {
+        const auto alpha_key = static_cast<unsigned char>(key[0]);
+
+        if (alpha_key >= FINGER_ALPHA_KEY.front() && alpha_key <= FINGER_ALPHA_KEY.back()) {
+          BasicAlphaEncoding::store(input.curl.fingers[alpha_key - FINGER_ALPHA_KEY.front()].curl_total, analog);
+          found = true;
+          return;
+        }
+
+        switch (alpha_key) {
+          case 'F':
+            BasicAlphaEncoding::store(input.joystick.x, analog);
+            found = true;
+            return;
+          case 'G':
+            BasicAlphaEncoding::store(input.joystick.y, analog);
+            found = true;
+            return;
+          case 'H':
+            BasicAlphaEncoding::store(input.joystick.press, true);
+            found = true;
+            return;
+          default:
+            break;
+        }
+
+        for (size_t i = 0; i < BUTTON_ALPHA_KEY.size(); i++) {
+          if (alpha_key == BUTTON_ALPHA_KEY[i]) {
+            BasicAlphaEncoding::store(input.buttons[i].press, true);
+            found = true;
+            return;
+          }
+        }
+
+        for (size_t i = 0; i < ANALOG_BUTTON_ALPHA_KEY.size(); i++) {
+          if (alpha_key == ANALOG_BUTTON_ALPHA_KEY[i]) {
+            BasicAlphaEncoding::store(input.analog_buttons[i].press, true);
+            if (!value.empty()) {
+              BasicAlphaEncoding::store(input.analog_buttons[i].value, analog);
+            }
+            found = true;
+            return;
+          }
+        }
+
+        return;
+      }
+
+      // Extended keys: `(AB)` is splay, `(AAB)` is joint #1 of the thumb
+      if (key.size() < 4 || key.front() != '(' || key.back() != ')') {
+        return;
+      }
+
+      const auto finger_key = static_cast<unsigned char>(key[1]);
+      if (finger_key < FINGER_ALPHA_KEY.front() || finger_key > FINGER_ALPHA_KEY.back()) {
+        return;
+      }
+      const auto finger = finger_key - FINGER_ALPHA_KEY.front();
+
+      if (key.size() == 4 && key[2] == 'B') {
+        BasicAlphaEncoding::store(input.splay.fingers[finger], analog);
+        found = true;
+      } else if (key.size() == 5 && key[2] == 'A' && key[3] >= 'A' && key[3] <= 'D') {
+        BasicAlphaEncoding::store(input.curl.fingers[finger].curl[key[3] - 'A'], analog);
+        found = true;
+      }
+    });
+
+    return found;
+  }
+
+  template<std::uint16_t MaxAnalogValue>
+  inline auto BasicAlphaEncoding<MaxAnalogValue>::decodeOutput(const uint8_t *buffer, size_t buffer_size) -> OutputData {
     if (buffer_size == 0) {
       return OutputInvalid{};
     }
 
     auto map = std::map<std::string, std::string>();
-    AlphaEncoding::splitPairs(reinterpret_cast<const char*>(buffer), buffer_size, map);
+    BasicAlphaEncoding::splitPairs(reinterpret_cast<const char*>(buffer), buffer_size, map);
 
     if (map.empty()) {
       return OutputInvalid{};
@@ -332,11 +649,53 @@ namespace opengloves {
       return haptics;
     }
 
+    const auto& channels = map.find(BasicAlphaEncoding::NEGOTIATION_CHANNELS_KEY);
+    const auto& rate = map.find(BasicAlphaEncoding::NEGOTIATION_RATE_KEY);
+    const auto& resolution = map.find(BasicAlphaEncoding::NEGOTIATION_RESOLUTION_KEY);
+
+    if (channels != map.end()) {
+      OutputSubscriptionData subscription{};
+      subscription.channels = static_cast<InputChannelMask>(BasicAlphaEncoding::parseUnsigned(channels->second));
+
+      if (rate != map.end()) {
+        subscription.rate = static_cast<std::uint16_t>(BasicAlphaEncoding::parseUnsigned(rate->second));
+      }
+
+      if (resolution != map.end()) {
+        subscription.resolution = static_cast<std::uint8_t>(BasicAlphaEncoding::parseUnsigned(resolution->second));
+      }
+
+      return subscription;
+    }
+
     return OutputInvalid{};
   }
 
+  template<std::uint16_t MaxAnalogValue>
+  inline auto BasicAlphaEncoding<MaxAnalogValue>::decodeMetadata(const uint8_t *buffer, size_t buffer_size) -> FrameMetadata {
+    FrameMetadata metadata{};
+
+    BasicAlphaEncoding::forEachPair(reinterpret_cast<const char*>(buffer), buffer_size, [&metadata](std::string_view key, std::string_view value) {
+      if (value.empty()) {
+        return;
+      }
+
+      const auto number = static_cast<std::uint32_t>(BasicAlphaEncoding::parseUnsigned(value));
+      if (key == BasicAlphaEncoding::METADATA_SEQUENCE_KEY) {
+        metadata.sequence = number;
+      } else if (key == BasicAlphaEncoding::METADATA_TIMESTAMP_KEY) {
+        metadata.timestamp = number;
+      } else if (key == BasicAlphaEncoding::METADATA_ECHO_TIMESTAMP_KEY) {
+        metadata.echo_timestamp = number;
+      }
+    });
+
+    return metadata;
+  }
+
   // todo: in theory, we can use std::string_view here, or const char*
-  inline auto AlphaEncoding::splitPairs(const char *buffer, size_t buffer_size, std::map<std::string, std::string> &pairs) -> void {
+  template<std::uint16_t MaxAnalogValue>
+  inline auto BasicAlphaEncoding<MaxAnalogValue>::splitPairs(const char *buffer, size_t buffer_size, std::map<std::string, std::string> &pairs) -> void {
     pairs.clear();
 
     if (buffer_size == 0) {
@@ -375,4 +734,75 @@ namespace opengloves {
       );
     }
   }
+
+  template<std::uint16_t MaxAnalogValue>
+  template<typename Fn>
+  inline auto BasicAlphaEncoding<MaxAnalogValue>::forEachPair(const char *buffer, size_t buffer_size, Fn &&fn) -> void {
+    const auto is_value = [](char c) { return isdigit(c) || c == '.'; };
+
+    size_t i = 0;
+    while (i < buffer_size && buffer[i] != '\n' && buffer[i] != '\0') {
+      // Keys are either a single letter, or a parenthesized sequence: A, (AB), (ZV)
+      size_t key_end = i;
+      if (buffer[i] == '(') {
+        while (key_end < buffer_size && buffer[key_end] != ')' && buffer[key_end] != '\n') {
+          key_end++;
+        }
+        if (key_end < buffer_size && buffer[key_end] == ')') {
+          key_end++;
+        }
+      } else if (!is_value(buffer[i])) {
+        key_end++;
+      }
+
+      size_t value_end = key_end;
+      while (value_end < buffer_size && is_value(buffer[value_end])) {
+        value_end++;
+      }
+
+      fn(std::string_view(buffer + i, key_end - i), std::string_view(buffer + key_end, value_end - key_end));
+
+      i = value_end;
+    }
+  }
+
+  template<std::uint16_t MaxAnalogValue>
+  inline auto BasicAlphaEncoding<MaxAnalogValue>::maxAnalogValue(std::uint8_t resolution) -> float {
+    if (resolution == 0) {
+      return MAX_ANALOG_VALUE;
+    }
+
+    const auto bits = std::min(resolution, MAX_RESOLUTION);
+    return static_cast<float>((1UL << bits) - 1);
+  }
+
+  template<std::uint16_t MaxAnalogValue>
+  inline auto BasicAlphaEncoding<MaxAnalogValue>::parseUnsigned(std::string_view value) -> unsigned long {
+    unsigned long result = 0;
+    for (const auto c : value) {
+      if (!isdigit(c)) {
+        break;
+      }
+      result = result * 10 + static_cast<unsigned long>(c - '0'); // NOLINT(*-magic-numbers)
+    }
+    return result;
+  }
+
+  template<std::uint16_t MaxAnalogValue>
+  template<typename T, typename V>
+  inline auto BasicAlphaEncoding<MaxAnalogValue>::store(T &target, V value) -> void {
+    if constexpr (std::is_pointer_v<T>) {
+      *target = value;
+    } else {
+      target = value;
+    }
+  }
+
+  /// Default encoding, with 12-bit analog values.
+  using AlphaEncoding = BasicAlphaEncoding<4095>;
+
+  using AlphaEncoding8 = BasicAlphaEncoding<255>;
+  using AlphaEncoding10 = BasicAlphaEncoding<1023>;
+  using AlphaEncoding12 = AlphaEncoding;
+  using AlphaEncoding16 = BasicAlphaEncoding<65535>;
 } // namespace opengloves
@@ -0,0 +1,396 @@
+#pragma once
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define OPENGLOVES_HAS_MMAP
+#endif
+
+namespace opengloves {
+  /// Fixed set of worker threads that run batches of indexed tasks.
+  ///
+  /// Every worker starts with a contiguous range of tasks and, once it runs dry, steals half of the remaining
+  /// range of another worker. The calling thread takes part as worker `0`.
+  class WorkStealingPool {
+    public:
+      /// `thread_count` includes the calling thread, `0` uses the hardware concurrency.
+      explicit WorkStealingPool(size_t thread_count = 0);
+      ~WorkStealingPool();
+
+      WorkStealingPool(const WorkStealingPool&) = delete;
+      auto operator=(const WorkStealingPool&) -> WorkStealingPool& = delete;
+
+      [[nodiscard]] auto size() const -> size_t { return this->queues_.size(); }
+
+      /// Call `fn(task)` for every task in `[0, task_count)`, and wait for all of them to finish.
+      /// If tasks throw, the remaining ones still run, and the first exception is rethrown on the calling thread.
+      template<typename Fn>
+      auto run(size_t task_count, Fn&& fn) -> void;
+
+    private:
+      struct alignas(64) Queue { // NOLINT(*-magic-numbers): keep queues on separate cache lines
+        std::mutex mutex;
+        size_t begin = 0;
+        size_t end = 0;
+      };
+
+      std::vector<Queue> queues_;
+      std::vector<std::thread> threads_;
+
+      std::mutex mutex_;
+      std::condition_variable wake_;
+      std::condition_variable done_;
+      size_t generation_ = 0;
+      size_t busy_ = 0;
+      bool stopping_ = false;
+
+      void* job_ = nullptr;
+      void (*call_)(void*, size_t) = nullptr;
+      std::exception_ptr error_;
+
+      auto workerLoop(size_t worker) -> void;
+      auto work(size_t worker) -> void;
+      auto pop(size_t worker, size_t& task) -> bool;
+      auto steal(size_t worker, size_t& task) -> bool;
+  };
+
+  inline WorkStealingPool::WorkStealingPool(size_t thread_count) :
+    queues_(thread_count != 0 ? thread_count : std::max<size_t>(1, std::thread::hardware_concurrency()))
+  {
+    for (size_t worker = 1; worker < this->queues_.size(); worker++) {
+      this->threads_.emplace_back([this, worker] { this->workerLoop(worker); });
+    }
+  }
+
+  inline WorkStealingPool::~WorkStealingPool() {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex_);
+      this->stopping_ = true;
+    }
+    this->wake_.notify_all();
+
+    for (auto& thread : this->threads_) {
+      thread.join();
+    }
+  }
+
+  template<typename Fn>
+  inline auto WorkStealingPool::run(size_t task_count, Fn&& fn) -> void {
+    if (task_count == 0) {
+      return;
+    }
+
+    const auto workers = this->queues_.size();
+    for (size_t worker = 0; worker < workers; worker++) {
+      auto& queue = this->queues_[worker];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.begin = task_count * worker / workers;
+      queue.end = task_count * (worker + 1) / workers;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(this->mutex_);
+      this->job_ = static_cast<void*>(&fn);
+      this->call_ = [](void* job, size_t task) { (*static_cast<std::remove_reference_t<Fn>*>(job))(task); };
+      this->busy_ = workers - 1;
+      this->generation_++;
+    }
+    this->wake_.notify_all();
+
+    this->work(0);
+
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    this->done_.wait(lock, [this] { return this->busy_ == 0; });
+    this->job_ = nullptr;
+    this->call_ = nullptr;
+
+    const auto error = std::exchange(this->error_, nullptr);
+    lock.unlock();
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  inline auto WorkStealingPool::workerLoop(size_t worker) -> void {
+    size_t seen_generation = 0;
+
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(this->mutex_);
+        this->wake_.wait(lock, [&] { return this->stopping_ || this->generation_ != seen_generation; });
+        if (this->stopping_) {
+          return;
+        }
+        seen_generation = this->generation_;
+      }
+
+      this->work(worker);
+
+      {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->busy_--;
+      }
+      this->done_.notify_one();
+    }
+  }
+
+  inline auto WorkStealingPool::work(size_t worker) -> void {
+    size_t task = 0;
+    while (this->pop(worker, task) || this->steal(worker, task)) {
+#ifdef __cpp_exceptions
+      // An exception escaping a worker thread would terminate the process, hand it to `run` instead
+      try {
+        this->call_(this->job_, task);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        if (!this->error_) {
+          this->error_ = std::current_exception();
+        }
+      }
+#else
+      this->call_(this->job_, task);
+#endif
+    }
+  }
+
+  inline auto WorkStealingPool::pop(size_t worker, size_t& task) -> bool {
+    auto& queue = this->queues_[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.begin == queue.end) {
+      return false;
+    }
+    task = queue.begin++;
+    return true;
+  }
+
+  inline auto WorkStealingPool::steal(size_t worker, size_t& task) -> bool {
+    const auto workers = this->queues_.size();
+
+    for (size_t offset = 1; offset < workers; offset++) {
+      auto& victim = this->queues_[(worker + offset) % workers];
+      size_t begin = 0;
+      size_t end = 0;
+
+      {
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        const auto remaining = victim.end - victim.begin;
+        if (remaining == 0) {
+          continue;
+        }
+
+        // Take the back half, the victim keeps working from the front
+        end = victim.end;
+        begin = end - (remaining + 1) / 2;
+        victim.end = begin;
+      }
+
+      auto& queue = this->queues_[worker];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      task = begin;
+      queue.begin = begin + 1;
+      queue.end = end;
+      return true;
+    }
+
+    return false;
+  }
+
+#ifdef OPENGLOVES_HAS_MMAP
+  /// Read-only memory mapping of a whole file.
+  class MappedFile {
+    public:
+      MappedFile() = default;
+      ~MappedFile() { this->close(); }
+
+      MappedFile(const MappedFile&) = delete;
+      auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+      /// \return `false` if the file could not be opened or mapped.
+      auto open(const char* path) -> bool;
+      auto close() -> void;
+
+      [[nodiscard]] auto data() const -> const uint8_t* { return this->data_; }
+      [[nodiscard]] auto size() const -> size_t { return this->size_; }
+
+    private:
+      const uint8_t* data_ = nullptr;
+      size_t size_ = 0;
+  };
+
+  inline auto MappedFile::open(const char* path) -> bool {
+    this->close();
+
+    const int fd = ::open(path, O_RDONLY); // NOLINT(*-vararg)
+    if (fd < 0) {
+      return false;
+    }
+
+    struct stat status{};
+    if (fstat(fd, &status) != 0) {
+      ::close(fd);
+      return false;
+    }
+
+    if (status.st_size == 0) {
+      ::close(fd);
+      return true;
+    }
+
+    void* mapping = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) { // NOLINT(*-cstyle-cast)
+      return false;
+    }
+
+    // We read the file front to back
+    madvise(mapping, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+
+    this->data_ = static_cast<const uint8_t*>(mapping);
+    this->size_ = static_cast<size_t>(status.st_size);
+    return true;
+  }
+
+  inline auto MappedFile::close() -> void {
+    if (this->data_ != nullptr) {
+      munmap(const_cast<uint8_t*>(this->data_), this->size_);
+    }
+    this->data_ = nullptr;
+    this->size_ = 0;
+  }
+#endif
+
+  /// Decodes large buffers of newline-delimited frames (e.g. recorded logs) on all cores.
+  ///
+  /// The buffer is split into chunks at line boundaries; lines are counted per chunk first, so every chunk knows
+  /// where its frames go and results land in the output array in their original order.
+  class BulkDecoder {
+    public:
+      inline static constexpr const size_t DEFAULT_CHUNK_SIZE = 256 * 1024;
+
+      explicit BulkDecoder(size_t thread_count = 0, size_t chunk_size = DEFAULT_CHUNK_SIZE) :
+        pool_(thread_count), chunk_size_(std::max<size_t>(1, chunk_size))
+      {
+      }
+
+      [[nodiscard]] auto threadCount() const -> size_t { return this->pool_.size(); }
+
+      /// Number of frames in the buffer, i.e. the output size `decode` needs.
+      /// A trailing line without a line break counts as a frame.
+      auto countFrames(const uint8_t* buffer, size_t buffer_size) -> size_t;
+
+      /// Decode every frame with `Encoding::decodeOutput`. Frames it throws on, e.g. numbers `std::stof` rejects,
+      /// decode to `OutputInvalid`, so one corrupt line does not lose the rest of a log.
+      /// \return The number of frames in the buffer, only the first `output_size` of them are written.
+      template<typename Encoding = AlphaEncoding>
+      auto decodeOutput(const uint8_t* buffer, size_t buffer_size, OutputData* output, size_t output_size) -> size_t;
+
+      /// Decode every frame with `decoder(frame, frame_size) -> T`. If it throws, the first exception is rethrown
+      /// once all frames were decoded.
+      template<typename T, typename Decoder>
+      auto decode(const uint8_t* buffer, size_t buffer_size, T* output, size_t output_size, Decoder&& decoder) -> size_t;
+
+    private:
+      struct Chunk {
+        size_t begin;
+        size_t end;
+        size_t first_frame;
+        size_t frame_count;
+      };
+
+      WorkStealingPool pool_;
+      size_t chunk_size_;
+      std::vector<Chunk> chunks_;
+
+      auto split(const uint8_t* buffer, size_t buffer_size) -> size_t;
+  };
+
+  inline auto BulkDecoder::split(const uint8_t* buffer, size_t buffer_size) -> size_t {
+    this->chunks_.clear();
+
+    for (size_t begin = 0; begin < buffer_size;) {
+      size_t end = std::min(begin + this->chunk_size_, buffer_size);
+      if (end < buffer_size) {
+        const auto* newline = static_cast<const uint8_t*>(std::memchr(buffer + end - 1, '\n', buffer_size - end + 1));
+        end = newline == nullptr ? buffer_size : static_cast<size_t>(newline - buffer) + 1;
+      }
+      this->chunks_.push_back({ begin, end, 0, 0 });
+      begin = end;
+    }
+
+    this->pool_.run(this->chunks_.size(), [this, buffer](size_t index) {
+      auto& chunk = this->chunks_[index];
+      size_t count = 0;
+
+      for (size_t offset = chunk.begin; offset < chunk.end;) {
+        const auto* newline = static_cast<const uint8_t*>(std::memchr(buffer + offset, '\n', chunk.end - offset));
+        count++;
+        offset = newline == nullptr ? chunk.end : static_cast<size_t>(newline - buffer) + 1;
+      }
+      chunk.frame_count = count;
+    });
+
+    size_t total = 0;
+    for (auto& chunk : this->chunks_) {
+      chunk.first_frame = total;
+      total += chunk.frame_count;
+    }
+    return total;
+  }
+
+  inline auto BulkDecoder::countFrames(const uint8_t* buffer, size_t buffer_size) -> size_t {
+    return this->split(buffer, buffer_size);
+  }
+
+  template<typename Encoding>
+  inline auto BulkDecoder::decodeOutput(const uint8_t* buffer, size_t buffer_size, OutputData* output, size_t output_size) -> size_t {
+#ifdef __cpp_exceptions
+    return this->decode(buffer, buffer_size, output, output_size, [](const uint8_t* frame, size_t frame_size) -> OutputData {
+      try {
+        return Encoding::decodeOutput(frame, frame_size);
+      } catch (const std::exception& /*error*/) {
+        return OutputInvalid{};
+      }
+    });
+#else
+    return this->decode(buffer, buffer_size, output, output_size, &Encoding::decodeOutput);
+#endif
+  }
+
+  template<typename T, typename Decoder>
+  inline auto BulkDecoder::decode(const uint8_t* buffer, size_t buffer_size, T* output, size_t output_size, Decoder&& decoder) -> size_t {
+    const auto total = this->split(buffer, buffer_size);
+
+    this->pool_.run(this->chunks_.size(), [&](size_t index) {
+      const auto& chunk = this->chunks_[index];
+      auto frame = chunk.first_frame;
+
+      for (size_t offset = chunk.begin; offset < chunk.end && frame < output_size; frame++) {
+        const auto* newline = static_cast<const uint8_t*>(std::memchr(buffer + offset, '\n', chunk.end - offset));
+        const auto end = newline == nullptr ? chunk.end : static_cast<size_t>(newline - buffer) + 1;
+
+        output[frame] = decoder(buffer + offset, end - offset);
+        offset = end;
+      }
+    });
+
+    return total;
+  }
+} // namespace opengloves
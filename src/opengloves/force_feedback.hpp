@@ -0,0 +1,123 @@
+#pragma once
+
+#include <opengloves.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+namespace opengloves {
+  /// Zero-initialized, this applies every frame as a step.
+  struct ForceFeedbackFingerConfig {
+    /// Spread every new target over the expected time until the next frame, instead of jumping to it.
+    /// Adds up to one frame interval of latency.
+    bool interpolate;
+
+    /// Fastest the output may move, in units per second, `0` for unlimited.
+    float max_slew_rate;
+  };
+
+  struct ForceFeedbackInterpolatorConfig {
+    InputFingers<ForceFeedbackFingerConfig> fingers;
+
+    /// Frames arriving further apart than this are treated as a new stream, and are not interpolated into,
+    /// in microseconds. `0` is 100 ms.
+    Timestamp max_interval;
+  };
+
+  /// Turns force feedback frames, arriving at the host's update rate, into smooth servo targets at the device's
+  /// (much faster) tick rate.
+  ///
+  /// Every finger ramps linearly from where it is towards the newest target, over the measured interval between
+  /// frames, and is then slew-rate limited. Both `push` and `tick` take constant time, and nothing is allocated.
+  class ForceFeedbackInterpolator {
+    public:
+      inline static constexpr const size_t FINGER_COUNT = 5;
+      inline static constexpr const Timestamp DEFAULT_MAX_INTERVAL = 100'000;
+
+      explicit ForceFeedbackInterpolator(const ForceFeedbackInterpolatorConfig& config = {}) : config_(config) {
+        if (this->config_.max_interval == 0) {
+          this->config_.max_interval = DEFAULT_MAX_INTERVAL;
+        }
+      }
+
+      [[nodiscard]] auto config() const -> const ForceFeedbackInterpolatorConfig& { return this->config_; }
+
+      /// Set a new target, from a frame that arrived at `arrival`.
+      auto push(Timestamp arrival, const OutputForceFeedbackData& target) -> void;
+
+      /// Servo targets at `now`. Expected to be called with non-decreasing times.
+      auto tick(Timestamp now) -> OutputForceFeedbackData;
+
+      /// Estimated interval between frames, in microseconds, `0` until two frames arrived.
+      [[nodiscard]] auto interval() const -> Timestamp { return this->interval_; }
+
+    private:
+      ForceFeedbackInterpolatorConfig config_;
+
+      bool has_frame_ = false;
+      Timestamp arrival_ = 0;
+      Timestamp interval_ = 0;
+
+      bool has_ticked_ = false;
+      Timestamp last_tick_ = 0;
+
+      std::array<float, FINGER_COUNT> from_{};
+      std::array<float, FINGER_COUNT> to_{};
+      std::array<float, FINGER_COUNT> output_{};
+  };
+
+  inline auto ForceFeedbackInterpolator::push(Timestamp arrival, const OutputForceFeedbackData& target) -> void {
+    const auto since = this->has_frame_ ? elapsed(this->arrival_, arrival) : -1;
+
+    if (since > 0 && static_cast<Timestamp>(since) <= this->config_.max_interval) {
+      // Smooth out the arrival jitter of the link, but follow rate changes within a few frames
+      this->interval_ = this->interval_ == 0 ? static_cast<Timestamp>(since) : (this->interval_ * 3 + static_cast<Timestamp>(since)) / 4;
+    } else if (since > 0) {
+      this->interval_ = 0;
+    }
+
+    for (size_t finger = 0; finger < FINGER_COUNT; finger++) {
+      // Ramp from wherever the output is now, so a late frame does not jump back to the previous target
+      this->from_[finger] = this->has_frame_ ? this->output_[finger] : target.fingers[finger];
+      this->to_[finger] = target.fingers[finger];
+    }
+
+    if (!this->has_frame_) {
+      this->output_ = this->to_;
+    }
+
+    this->has_frame_ = true;
+    this->arrival_ = arrival;
+  }
+
+  inline auto ForceFeedbackInterpolator::tick(Timestamp now) -> OutputForceFeedbackData {
+    OutputForceFeedbackData result{};
+    if (!this->has_frame_) {
+      return result;
+    }
+
+    const auto dt = this->has_ticked_ ? static_cast<float>(std::max<std::int32_t>(elapsed(this->last_tick_, now), 0)) * 1e-6F : 0.0F;
+    this->has_ticked_ = true;
+    this->last_tick_ = now;
+
+    const auto since = std::max<std::int32_t>(elapsed(this->arrival_, now), 0);
+    const auto progress = this->interval_ == 0 ? 1.0F : std::min(static_cast<float>(since) / static_cast<float>(this->interval_), 1.0F);
+
+    for (size_t finger = 0; finger < FINGER_COUNT; finger++) {
+      const auto& config = this->config_.fingers.fingers[finger];
+
+      auto value = config.interpolate ? this->from_[finger] + (this->to_[finger] - this->from_[finger]) * progress : this->to_[finger];
+
+      if (config.max_slew_rate > 0.0F) {
+        const auto step = config.max_slew_rate * dt;
+        value = std::min(std::max(value, this->output_[finger] - step), this->output_[finger] + step);
+      }
+
+      this->output_[finger] = value;
+      result.fingers[finger] = value;
+    }
+
+    return result;
+  }
+} // namespace opengloves
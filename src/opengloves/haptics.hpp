@@ -0,0 +1,225 @@
+#pragma once
+
+#include <opengloves.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace opengloves {
+  using HapticsWaveformIndex = std::uint8_t;
+  enum HapticsWaveform : HapticsWaveformIndex {
+    /// Amplitude only, for eccentric rotating mass motors that set their own frequency.
+    HapticsWaveform_Constant = 0,
+
+    /// On for the first half of every period.
+    HapticsWaveform_Square,
+
+    /// For voice coils and linear resonant actuators.
+    HapticsWaveform_Sine,
+  };
+
+  struct HapticsConfig {
+    HapticsWaveform waveform = HapticsWaveform_Square;
+
+    /// Overlapping effects whose frequencies differ by less than this fraction merge into one.
+    float merge_tolerance = 0.1F; // NOLINT(*-magic-numbers)
+  };
+
+  /// Renders decoded haptics commands into actuator duty values, without blocking the loop that decodes them.
+  ///
+  /// One effect plays at a time. A new effect that overlaps the playing one either merges with it (similar
+  /// frequency: longest duration, strongest amplitude), preempts it (at least as strong; the remainder of the
+  /// preempted effect resumes afterwards), or waits in a pool of `PoolSize` pending effects until it is the
+  /// strongest one left. Effects keep their absolute end time, so waiting eats into their duration.
+  ///
+  /// `tick()` is meant for a timer callback: it does constant work, except when the playing effect ends and the
+  /// next one is picked from the pool.
+  template<size_t PoolSize = 8>
+  class HapticsScheduler {
+    public:
+      /// Longest effect, in microseconds (about 35 minutes); longer ones are cut to it, so their end stays within
+      /// the range `elapsed()` can compare.
+      inline static constexpr const Timestamp MAX_DURATION = 0x7FFF'FFFF;
+
+      explicit HapticsScheduler(const HapticsConfig& config = {}) : config_(config) {}
+
+      [[nodiscard]] auto config() const -> const HapticsConfig& { return this->config_; }
+
+      /// Queue an effect starting at `now`. Frequency is in Hz, duration in seconds (at most `MAX_DURATION`) and
+      /// amplitude in `[0, 1]`.
+      /// \return `false` if the effect was dropped: empty, or weaker than everything in a full pool.
+      auto push(Timestamp now, const OutputHapticsData& command) -> bool;
+
+      /// Queue `output` if it is a haptics command.
+      /// \return `true` if the output was a haptics command, other outputs are left to the caller.
+      auto handleOutput(Timestamp now, const OutputData& output) -> bool {
+        const auto* haptics = std::get_if<OutputHapticsData>(&output);
+        if (haptics == nullptr) {
+          return false;
+        }
+
+        this->push(now, *haptics);
+        return true;
+      }
+
+      /// Duty value of the actuator at `now`, in `[0, 1]`.
+      auto tick(Timestamp now) -> float;
+
+      /// Drop the playing and every pending effect.
+      auto stop() -> void {
+        this->playing_ = false;
+        this->pool_.fill({});
+      }
+
+      [[nodiscard]] auto playing() const -> bool { return this->playing_; }
+
+      [[nodiscard]] auto pending() const -> size_t {
+        return static_cast<size_t>(std::count_if(this->pool_.begin(), this->pool_.end(), [](const Effect& effect) { return effect.used; }));
+      }
+
+    private:
+      struct Effect {
+        Timestamp start;
+        Timestamp end;
+        float amplitude;
+        float frequency;
+        /// Phase advance per microsecond, a full period being 2^32
+        std::uint32_t phase_step;
+        bool used;
+      };
+
+      HapticsConfig config_;
+
+      Effect current_{};
+      bool playing_ = false;
+      std::array<Effect, PoolSize> pool_{};
+
+      auto stash(const Effect& effect) -> bool;
+
+      /// Play the strongest pending effect that has not ended yet.
+      auto next(Timestamp now) -> void;
+  };
+
+  template<size_t PoolSize>
+  inline auto HapticsScheduler<PoolSize>::push(Timestamp now, const OutputHapticsData& command) -> bool {
+    const auto amplitude = std::min(std::max(command.amplitude, 0.0F), 1.0F);
+    const auto duration = static_cast<Timestamp>(
+        std::min(static_cast<double>(std::max(command.duration, 0.0F)) * 1e6, static_cast<double>(MAX_DURATION))
+    );
+    if (duration == 0 || amplitude == 0.0F) {
+      return false;
+    }
+
+    const auto frequency = std::max(command.frequency, 0.0F);
+    const Effect effect{
+      now,
+      now + duration,
+      amplitude,
+      frequency,
+      static_cast<std::uint32_t>(std::lround(static_cast<double>(frequency) * 4294.967296)), // NOLINT(*-magic-numbers): 2^32 / 1e6
+      true,
+    };
+
+    if (!this->playing_ || elapsed(this->current_.end, now) >= 0) {
+      this->current_ = effect;
+      this->playing_ = true;
+      return true;
+    }
+
+    // Merge with a similar effect, so repeated commands (e.g. a rumble refreshed every frame) play continuously
+    const auto tolerance = this->config_.merge_tolerance * std::max(frequency, this->current_.frequency);
+    if (std::abs(frequency - this->current_.frequency) <= tolerance) {
+      if (elapsed(this->current_.end, effect.end) > 0) {
+        this->current_.end = effect.end;
+      }
+      this->current_.amplitude = std::max(this->current_.amplitude, amplitude);
+      return true;
+    }
+
+    if (amplitude < this->current_.amplitude) {
+      return this->stash(effect);
+    }
+
+    // Preempt; the rest of the current effect plays afterwards, if there is any left then
+    if (elapsed(effect.end, this->current_.end) > 0) {
+      this->stash(this->current_);
+    }
+    this->current_ = effect;
+    return true;
+  }
+
+  template<size_t PoolSize>
+  inline auto HapticsScheduler<PoolSize>::stash(const Effect& effect) -> bool {
+    auto* slot = &this->pool_[0];
+
+    for (auto& candidate : this->pool_) {
+      if (!candidate.used) {
+        slot = &candidate;
+        break;
+      }
+      if (candidate.amplitude < slot->amplitude) {
+        slot = &candidate;
+      }
+    }
+
+    if (slot->used && slot->amplitude >= effect.amplitude) {
+      return false;
+    }
+
+    *slot = effect;
+    return true;
+  }
+
+  template<size_t PoolSize>
+  inline auto HapticsScheduler<PoolSize>::next(Timestamp now) -> void {
+    Effect* strongest = nullptr;
+
+    for (auto& effect : this->pool_) {
+      if (!effect.used) {
+        continue;
+      }
+      if (elapsed(effect.end, now) >= 0) {
+        effect.used = false;
+        continue;
+      }
+      if (strongest == nullptr || effect.amplitude > strongest->amplitude) {
+        strongest = &effect;
+      }
+    }
+
+    this->playing_ = strongest != nullptr;
+    if (strongest != nullptr) {
+      this->current_ = *strongest;
+      strongest->used = false;
+    }
+  }
+
+  template<size_t PoolSize>
+  inline auto HapticsScheduler<PoolSize>::tick(Timestamp now) -> float {
+    if (this->playing_ && elapsed(this->current_.end, now) >= 0) {
+      this->next(now);
+    }
+    if (!this->playing_) {
+      return 0.0F;
+    }
+
+    const auto& effect = this->current_;
+    if (this->config_.waveform == HapticsWaveform_Constant || effect.phase_step == 0) {
+      return effect.amplitude;
+    }
+
+    // Phase is continuous from the start of the effect, even across preemption
+    const auto since = static_cast<std::uint32_t>(std::max<std::int32_t>(elapsed(effect.start, now), 0));
+    const auto phase = static_cast<std::uint32_t>(static_cast<std::uint64_t>(since) * effect.phase_step);
+
+    if (this->config_.waveform == HapticsWaveform_Square) {
+      return phase < 0x8000'0000U ? effect.amplitude : 0.0F;
+    }
+
+    constexpr float PHASE_TO_RADIANS = 6.283185307179586F / 4294967296.0F;
+    return effect.amplitude * (0.5F + 0.5F * std::sin(static_cast<float>(phase) * PHASE_TO_RADIANS));
+  }
+} // namespace opengloves
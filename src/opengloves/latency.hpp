@@ -0,0 +1,198 @@
+#pragma once
+
+#include <opengloves.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace opengloves {
+  /// Histogram of latencies in microseconds, with power-of-two buckets.
+  ///
+  /// Bucket `0` holds `[0, 1)`, bucket `i` holds `[2^(i-1), 2^i)`, and the last one everything above.
+  /// Fixed-size and allocation-free, so it can live on the device as well.
+  class LatencyHistogram {
+    public:
+      inline static constexpr const size_t BUCKET_COUNT = 32;
+
+      auto record(std::int32_t latency) -> void {
+        // Negative latencies only come from unsynchronized clocks, they still count towards the total
+        const auto value = static_cast<std::uint32_t>(std::max<std::int32_t>(latency, 0));
+
+        this->buckets_[LatencyHistogram::bucketOf(value)]++;
+        this->count_++;
+        this->sum_ += value;
+        this->min_ = std::min(this->min_, value);
+        this->max_ = std::max(this->max_, value);
+      }
+
+      auto reset() -> void { *this = LatencyHistogram(); }
+
+      [[nodiscard]] auto count() const -> std::uint32_t { return this->count_; }
+      [[nodiscard]] auto min() const -> std::uint32_t { return this->count_ == 0 ? 0 : this->min_; }
+      [[nodiscard]] auto max() const -> std::uint32_t { return this->max_; }
+      [[nodiscard]] auto mean() const -> std::uint32_t {
+        return this->count_ == 0 ? 0 : static_cast<std::uint32_t>(this->sum_ / this->count_);
+      }
+
+      [[nodiscard]] auto buckets() const -> const std::array<std::uint32_t, BUCKET_COUNT>& { return this->buckets_; }
+
+      /// Upper bound of the bucket that contains the `quantile` (0..1) of all recorded values.
+      [[nodiscard]] auto percentile(float quantile) const -> std::uint32_t;
+
+      /// Bucket index of a latency value.
+      [[nodiscard]] static auto bucketOf(std::uint32_t value) -> size_t {
+        size_t bucket = 0;
+        while (value != 0 && bucket < BUCKET_COUNT - 1) {
+          value >>= 1U;
+          bucket++;
+        }
+        return bucket;
+      }
+
+    private:
+      std::array<std::uint32_t, BUCKET_COUNT> buckets_{};
+      std::uint32_t count_ = 0;
+      std::uint64_t sum_ = 0;
+      std::uint32_t min_ = std::numeric_limits<std::uint32_t>::max();
+      std::uint32_t max_ = 0;
+  };
+
+  inline auto LatencyHistogram::percentile(float quantile) const -> std::uint32_t {
+    if (this->count_ == 0) {
+      return 0;
+    }
+
+    const auto target = static_cast<std::uint32_t>(quantile * static_cast<float>(this->count_));
+    std::uint32_t seen = 0;
+
+    for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+      seen += this->buckets_[bucket];
+      if (seen > target || seen == this->count_) {
+        return std::min(bucket == 0 ? 1U : (1U << bucket), this->max_);
+      }
+    }
+
+    return this->max_;
+  }
+
+  struct LinkStatistics {
+    std::uint32_t received;
+
+    /// Frames that never arrived, reordered frames that turn up later are subtracted again. Frames more than
+    /// `LatencyTracker::REORDER_WINDOW` late cannot be told from duplicates, and stay lost.
+    std::uint32_t lost;
+
+    /// Frames that arrived after a newer one, within the reorder window.
+    std::uint32_t reordered;
+
+    std::uint32_t duplicates;
+  };
+
+  /// Latency, loss and reordering statistics of one end of a link.
+  ///
+  /// Stamp outgoing frames with `stamp()`, and feed the metadata of every incoming frame to `receive()`.
+  /// One-way latency is only meaningful if both ends share a clock (e.g. a loopback, or a synchronized host);
+  /// round-trip time uses the echoed timestamp and only needs the local clock.
+  class LatencyTracker {
+    public:
+      /// How far back (in sequence numbers) duplicates and late frames are told apart.
+      inline static constexpr const std::uint32_t REORDER_WINDOW = 64;
+
+      /// Metadata for the next outgoing frame.
+      auto stamp(Timestamp now) -> FrameMetadata;
+
+      /// Account an incoming frame, received at `now`.
+      auto receive(const FrameMetadata& metadata, Timestamp now) -> void;
+
+      auto reset() -> void { *this = LatencyTracker(); }
+
+      [[nodiscard]] auto oneWay() const -> const LatencyHistogram& { return this->one_way_; }
+      [[nodiscard]] auto roundTrip() const -> const LatencyHistogram& { return this->round_trip_; }
+      [[nodiscard]] auto statistics() const -> const LinkStatistics& { return this->statistics_; }
+
+    private:
+      std::uint32_t next_sequence_ = 0;
+      std::optional<Timestamp> peer_timestamp_;
+
+      bool has_highest_ = false;
+      std::uint32_t highest_sequence_ = 0;
+      /// Bit `i` is set if `highest_sequence_ - i` has been received
+      std::uint64_t received_mask_ = 0;
+
+      LatencyHistogram one_way_;
+      LatencyHistogram round_trip_;
+      LinkStatistics statistics_{};
+
+      auto receiveSequence(std::uint32_t sequence) -> void;
+  };
+
+  inline auto LatencyTracker::stamp(Timestamp now) -> FrameMetadata {
+    FrameMetadata metadata{};
+    metadata.sequence = this->next_sequence_++;
+    metadata.timestamp = now;
+    metadata.echo_timestamp = this->peer_timestamp_;
+
+    return metadata;
+  }
+
+  inline auto LatencyTracker::receive(const FrameMetadata& metadata, Timestamp now) -> void {
+    this->statistics_.received++;
+
+    if (metadata.sequence.has_value()) {
+      this->receiveSequence(*metadata.sequence);
+    }
+
+    if (metadata.timestamp.has_value()) {
+      this->one_way_.record(elapsed(*metadata.timestamp, now));
+
+      if (!this->peer_timestamp_.has_value() || elapsed(*this->peer_timestamp_, *metadata.timestamp) > 0) {
+        this->peer_timestamp_ = metadata.timestamp;
+      }
+    }
+
+    if (metadata.echo_timestamp.has_value()) {
+      this->round_trip_.record(elapsed(*metadata.echo_timestamp, now));
+    }
+  }
+
+  inline auto LatencyTracker::receiveSequence(std::uint32_t sequence) -> void {
+    if (!this->has_highest_) {
+      this->has_highest_ = true;
+      this->highest_sequence_ = sequence;
+      this->received_mask_ = 1;
+      return;
+    }
+
+    const auto ahead = static_cast<std::int32_t>(sequence - this->highest_sequence_);
+
+    if (ahead > 0) {
+      // Everything in between is lost, until it turns up
+      this->statistics_.lost += static_cast<std::uint32_t>(ahead - 1);
+      this->received_mask_ = static_cast<std::uint32_t>(ahead) >= REORDER_WINDOW ? 0 : this->received_mask_ << static_cast<std::uint32_t>(ahead);
+      this->received_mask_ |= 1U;
+      this->highest_sequence_ = sequence;
+      return;
+    }
+
+    const auto behind = this->highest_sequence_ - sequence;
+    if (behind >= REORDER_WINDOW) {
+      // Too late to tell whether it is a duplicate, it was given up on as lost and stays so
+      return;
+    }
+
+    const auto bit = std::uint64_t{ 1 } << behind;
+    if ((this->received_mask_ & bit) != 0) {
+      this->statistics_.duplicates++;
+      return;
+    }
+
+    this->received_mask_ |= bit;
+    this->statistics_.reordered++;
+    if (this->statistics_.lost > 0) {
+      this->statistics_.lost--;
+    }
+  }
+} // namespace opengloves
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <opengloves.hpp>
+#include <opengloves/latency.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace opengloves {
+  struct LinkConfig {
+    /// Line rate, in bits per second.
+    std::uint32_t baud_rate = 115'200; // NOLINT(*-magic-numbers)
+
+    /// Bits on the wire per payload byte, e.g. 10 for 8N1 UART framing.
+    std::uint8_t bits_per_byte = 10; // NOLINT(*-magic-numbers)
+
+    /// Largest payload per packet in bytes, e.g. the ATT MTU of a BLE characteristic; `0` for a plain byte stream.
+    std::uint16_t mtu = 0;
+
+    /// Bytes every packet adds on the wire, e.g. BLE link layer and ATT headers.
+    std::uint16_t packet_overhead = 0;
+
+    /// Shortest time between the starts of two packets, in microseconds, e.g. a BLE connection interval divided by
+    /// the packets per connection event; `0` for none.
+    Timestamp packet_interval = 0;
+
+    /// Transmit buffer, in payload bytes; frames that do not fit are dropped. `0` for unlimited.
+    std::uint32_t queue_size = 0;
+  };
+
+  /// Host-side model of a serial or BLE link, for sizing baud rates and loop rates without the hardware.
+  ///
+  /// Frames go out whole and in order: each is split into packets of at most `mtu` bytes, which take their bits
+  /// (payload and overhead) over the baud rate each, and start no sooner than `packet_interval` apart. A frame is
+  /// delivered once its last packet arrived; its latency is the time it queued behind earlier frames plus its
+  /// own transmission time.
+  class LinkSimulator {
+    public:
+      explicit LinkSimulator(const LinkConfig& config = {}) : config_(config) {}
+
+      [[nodiscard]] auto config() const -> const LinkConfig& { return this->config_; }
+
+      /// Queue a frame at `now`. Expected to be called with non-decreasing times.
+      /// \return `false` if the transmit buffer is full and the frame was dropped.
+      auto send(Timestamp now, const uint8_t* frame, size_t frame_size) -> bool;
+
+      /// Call `fn(frame, frame_size, latency)` for every frame delivered by `now`, in order.
+      /// \return The number of delivered frames.
+      template<typename Fn>
+      auto receive(Timestamp now, Fn&& fn) -> size_t;
+
+      /// Time the link needs to transmit a frame of `frame_size` bytes, in microseconds, ignoring `packet_interval`.
+      [[nodiscard]] auto transmissionTime(size_t frame_size) const -> Timestamp;
+
+      /// Payload bytes queued or on the wire at `now`.
+      [[nodiscard]] auto queued(Timestamp now) const -> size_t;
+
+      [[nodiscard]] auto sent() const -> std::uint32_t { return this->sent_; }
+      [[nodiscard]] auto dropped() const -> std::uint32_t { return this->dropped_; }
+      [[nodiscard]] auto delivered() const -> std::uint32_t { return this->latency_.count(); }
+
+      /// Latency of delivered frames, from `send` to delivery.
+      [[nodiscard]] auto latency() const -> const LatencyHistogram& { return this->latency_; }
+
+    private:
+      struct Frame {
+        Timestamp sent;
+        Timestamp delivery;
+        std::vector<uint8_t> data;
+      };
+
+      LinkConfig config_;
+
+      /// In delivery order, kept until `receive` handed them out
+      std::deque<Frame> frames_;
+
+      /// The wire is busy until this time, packets may start again at `next_packet_`
+      bool started_ = false;
+      Timestamp busy_until_ = 0;
+      Timestamp next_packet_ = 0;
+
+      std::uint32_t sent_ = 0;
+      std::uint32_t dropped_ = 0;
+      LatencyHistogram latency_;
+
+      /// Wire time of `bytes` payload bytes in one packet, in microseconds, rounded up.
+      [[nodiscard]] auto packetTime(size_t bytes) const -> Timestamp;
+  };
+
+  inline auto LinkSimulator::packetTime(size_t bytes) const -> Timestamp {
+    const auto bits = static_cast<std::uint64_t>(bytes + this->config_.packet_overhead) * this->config_.bits_per_byte;
+    const auto baud_rate = std::max<std::uint64_t>(this->config_.baud_rate, 1);
+    return static_cast<Timestamp>((bits * 1'000'000U + baud_rate - 1) / baud_rate);
+  }
+
+  inline auto LinkSimulator::transmissionTime(size_t frame_size) const -> Timestamp {
+    if (this->config_.mtu == 0) {
+      return this->packetTime(frame_size);
+    }
+
+    const auto full_packets = frame_size / this->config_.mtu;
+    const auto rest = frame_size % this->config_.mtu;
+    return static_cast<Timestamp>(full_packets) * this->packetTime(this->config_.mtu) + (rest != 0 ? this->packetTime(rest) : 0);
+  }
+
+  inline auto LinkSimulator::queued(Timestamp now) const -> size_t {
+    size_t bytes = 0;
+
+    // Undelivered frames are at the back, delivered ones only wait for `receive`
+    for (auto frame = this->frames_.rbegin(); frame != this->frames_.rend() && elapsed(frame->delivery, now) < 0; ++frame) {
+      bytes += frame->data.size();
+    }
+    return bytes;
+  }
+
+  inline auto LinkSimulator::send(Timestamp now, const uint8_t* frame, size_t frame_size) -> bool {
+    if (this->config_.queue_size != 0 && this->queued(now) + frame_size > this->config_.queue_size) {
+      this->dropped_++;
+      return false;
+    }
+    this->sent_++;
+
+    // An idle wire starts right away, as long as the packet interval allows
+    if (!this->started_) {
+      this->started_ = true;
+      this->busy_until_ = now;
+      this->next_packet_ = now;
+    }
+    if (elapsed(this->busy_until_, now) > 0) {
+      this->busy_until_ = now;
+    }
+    if (elapsed(this->next_packet_, now) > 0) {
+      this->next_packet_ = now;
+    }
+
+    const auto packet_size = this->config_.mtu == 0 ? std::max<size_t>(frame_size, 1) : this->config_.mtu;
+    for (size_t offset = 0; offset < frame_size; offset += packet_size) {
+      const auto start = elapsed(this->busy_until_, this->next_packet_) > 0 ? this->next_packet_ : this->busy_until_;
+      this->busy_until_ = start + this->packetTime(std::min(packet_size, frame_size - offset));
+      this->next_packet_ = start + this->config_.packet_interval;
+    }
+
+    this->frames_.push_back({ now, this->busy_until_, std::vector<uint8_t>(frame, frame + frame_size) });
+    return true;
+  }
+
+  template<typename Fn>
+  inline auto LinkSimulator::receive(Timestamp now, Fn&& fn) -> size_t {
+    size_t count = 0;
+
+    while (!this->frames_.empty() && elapsed(this->frames_.front().delivery, now) >= 0) {
+      const auto& frame = this->frames_.front();
+      const auto latency = elapsed(frame.sent, frame.delivery);
+
+      this->latency_.record(latency);
+      fn(frame.data.data(), frame.data.size(), latency);
+
+      this->frames_.pop_front();
+      count++;
+    }
+
+    return count;
+  }
+} // namespace opengloves
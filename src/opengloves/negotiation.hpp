@@ -0,0 +1,89 @@
+#pragma once
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace opengloves {
+  /// Clamp the subscription a host asks for to what the device advertised.
+  ///
+  /// Devices that do not advertise (older firmware) are assumed to send every channel, as fast as they can.
+  inline auto negotiateSubscription(const InputInfoData& advertised, const OutputSubscriptionData& wanted) -> OutputSubscriptionData {
+    OutputSubscriptionData subscription = wanted;
+
+    const InputChannelMask available = advertised.channels != 0 ? advertised.channels : InputChannelMask{ InputChannel_All };
+    subscription.channels = wanted.channels & available;
+
+    if (advertised.max_rate != 0) {
+      subscription.rate = wanted.rate == 0 ? advertised.max_rate : std::min(wanted.rate, advertised.max_rate);
+    }
+
+    return subscription;
+  }
+
+  /// Device end of the negotiation: advertises the capabilities in the info frame, and encodes peripheral frames
+  /// according to the latest subscription of the host, dropping unsubscribed channels and frames above the rate.
+  template<typename Encoding = AlphaEncoding>
+  class SubscribedInputEncoder {
+    public:
+      /// `info` is what gets advertised, its `channels` and `max_rate` are the upper bounds of every subscription.
+      explicit SubscribedInputEncoder(const InputInfoData& info) :
+        info_(info), subscription_(negotiateSubscription(info, OutputSubscriptionData{ InputChannel_All, 0, 0 }))
+      {
+      }
+
+      [[nodiscard]] auto info() const -> const InputInfoData& { return this->info_; }
+      [[nodiscard]] auto subscription() const -> const OutputSubscriptionData& { return this->subscription_; }
+
+      auto encodeInfo(uint8_t* buffer, int buffer_size) const -> int {
+        return Encoding::encodeInputInfo(this->info_, buffer, buffer_size);
+      }
+
+      /// Apply the subscription if `output` is one.
+      /// \return `true` if the output was a subscription, other outputs are left to the caller.
+      auto handleOutput(const OutputData& output) -> bool;
+
+      /// Encode `input` if a frame is due at `now`.
+      /// \return The number of bytes written, `0` if the frame was dropped to keep the subscribed rate.
+      auto encode(Timestamp now, const InputPeripheralData& input, uint8_t* buffer, int buffer_size) -> int;
+
+    private:
+      InputInfoData info_;
+      OutputSubscriptionData subscription_;
+
+      bool started_ = false;
+      Timestamp next_due_ = 0;
+  };
+
+  template<typename Encoding>
+  inline auto SubscribedInputEncoder<Encoding>::handleOutput(const OutputData& output) -> bool {
+    if (!std::holds_alternative<OutputSubscriptionData>(output)) {
+      return false;
+    }
+
+    this->subscription_ = negotiateSubscription(this->info_, std::get<OutputSubscriptionData>(output));
+    this->started_ = false;
+    return true;
+  }
+
+  template<typename Encoding>
+  inline auto SubscribedInputEncoder<Encoding>::encode(Timestamp now, const InputPeripheralData& input, uint8_t* buffer, int buffer_size) -> int {
+    if (this->subscription_.rate != 0) {
+      const auto interval = static_cast<Timestamp>(1'000'000U / this->subscription_.rate); // NOLINT(*-magic-numbers)
+
+      if (this->started_ && elapsed(this->next_due_, now) < 0) {
+        return 0;
+      }
+
+      // Keep the cadence of the schedule, unless the loop stalled for more than a frame
+      this->next_due_ = this->started_ && elapsed(this->next_due_, now) < static_cast<std::int32_t>(interval)
+                          ? this->next_due_ + interval
+                          : now + interval;
+      this->started_ = true;
+    }
+
+    return Encoding::encodeInputPeripheral(input, this->subscription_, buffer, buffer_size);
+  }
+} // namespace opengloves
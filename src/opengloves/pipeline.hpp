@@ -0,0 +1,333 @@
+#pragma once
+
+#include <opengloves.hpp>
+#include <opengloves/state_table.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace opengloves {
+  using FilterTypeIndex = std::uint8_t;
+  enum FilterType : FilterTypeIndex {
+    FilterType_None = 0,
+
+    /// Exponential moving average, `ema_alpha` is the weight of the newest sample.
+    FilterType_Ema,
+
+    /// One-euro filter: low-pass with a cutoff that rises with speed, so it is smooth at rest and responsive in motion.
+    /// See: https://gery.casiez.net/1euro/
+    FilterType_OneEuro,
+  };
+
+  /// Processing settings of a single channel.
+  ///
+  /// Zero-initialized config is a passthrough, so it can be used inside `InputFingers` unions.
+  struct ChannelConfig {
+    /// Map the calibrated `[min, max]` range of every glove to `[0, 1]`.
+    bool calibrate;
+
+    /// Values closer than `deadzone` to either end of the range snap to it, the rest is stretched back to `[0, 1]`.
+    /// At most `kernels::MAX_DEADZONE`, larger ones are clamped to it.
+    float deadzone;
+
+    FilterType filter;
+
+    float ema_alpha;
+
+    float one_euro_min_cutoff;
+    float one_euro_beta;
+    float one_euro_derivative_cutoff;
+  };
+
+  struct InputPipelineConfig {
+    InputFingers<InputFingerCurl<ChannelConfig>> curl;
+    InputFingers<ChannelConfig> splay;
+    ChannelConfig joystick;
+    ChannelConfig analog_buttons;
+  };
+
+  /// Per-channel kernels, written as plain loops over contiguous columns so the compiler can vectorize them.
+  namespace kernels {
+    inline auto trackRange(const float* __restrict values, float* __restrict min, float* __restrict max, size_t count) -> void {
+      for (size_t i = 0; i < count; i++) {
+        min[i] = std::min(min[i], values[i]);
+        max[i] = std::max(max[i], values[i]);
+      }
+    }
+
+    /// Map `[min, max]` to `[0, 1]`, values with an empty range are passed through.
+    inline auto mapRange(float* __restrict values, const float* __restrict min, const float* __restrict max, size_t count) -> void {
+      constexpr const float EPSILON = 1e-6F;
+
+      for (size_t i = 0; i < count; i++) {
+        const auto range = max[i] - min[i];
+        values[i] = range > EPSILON ? (values[i] - min[i]) / range : values[i];
+      }
+    }
+
+    inline auto clamp(float* __restrict values, float low, float high, size_t count) -> void {
+      for (size_t i = 0; i < count; i++) {
+        values[i] = std::min(std::max(values[i], low), high);
+      }
+    }
+
+    /// Widest deadzone; at `0.5` the two ends meet, and the stretch becomes infinite.
+    inline constexpr const float MAX_DEADZONE = 0.49F;
+
+    /// Snap values near `0` and `1` to the ends and stretch the rest back to `[0, 1]`.
+    inline auto deadzone(float* __restrict values, float deadzone, size_t count) -> void {
+      const auto width = std::min(std::max(deadzone, 0.0F), MAX_DEADZONE);
+      const auto scale = 1.0F / (1.0F - 2.0F * width);
+
+      for (size_t i = 0; i < count; i++) {
+        values[i] = (values[i] - width) * scale;
+      }
+      clamp(values, 0.0F, 1.0F, count);
+    }
+
+    /// Snap a filter state that is within float noise of its target.
+    /// Without it, a channel resting at exactly zero decays geometrically into (very slow) denormals.
+    inline auto settle(float state, float target) -> float {
+      constexpr const float EPSILON = 1e-7F;
+
+      return std::fabs(state - target) < EPSILON ? target : state;
+    }
+
+    inline auto ema(float* __restrict values, float* __restrict state, float alpha, size_t count) -> void {
+      for (size_t i = 0; i < count; i++) {
+        state[i] = settle(state[i] + alpha * (values[i] - state[i]), values[i]);
+        values[i] = state[i];
+      }
+    }
+
+    /// Smoothing factor of a first-order low-pass filter with the given cutoff (Hz) and sample period (s).
+    inline auto lowPassAlpha(float cutoff, float dt) -> float {
+      constexpr const float TWO_PI = 6.28318530718F;
+
+      return 1.0F / (1.0F + 1.0F / (TWO_PI * cutoff * dt));
+    }
+
+    inline auto oneEuro(
+      float* __restrict values,
+      float* __restrict state,
+      float* __restrict derivative,
+      float min_cutoff,
+      float beta,
+      float derivative_cutoff,
+      float dt,
+      size_t count
+    ) -> void {
+      // Frames with the same (or an older) timestamp carry no velocity, keep the state instead of dividing by zero
+      if (!(dt > 0.0F)) {
+        for (size_t i = 0; i < count; i++) {
+          values[i] = state[i];
+        }
+        return;
+      }
+
+      const auto derivative_alpha = lowPassAlpha(derivative_cutoff, dt);
+      const auto inverse_dt = 1.0F / dt;
+
+      for (size_t i = 0; i < count; i++) {
+        derivative[i] = settle(derivative[i] + derivative_alpha * ((values[i] - state[i]) * inverse_dt - derivative[i]), 0.0F);
+
+        const auto cutoff = min_cutoff + beta * std::fabs(derivative[i]);
+        const auto alpha = lowPassAlpha(cutoff, dt);
+
+        state[i] = settle(state[i] + alpha * (values[i] - state[i]), values[i]);
+        values[i] = state[i];
+      }
+    }
+  } // namespace kernels
+
+  /// Calibration, deadzone and filtering of decoded input, for one or many gloves at once.
+  ///
+  /// All state is allocated at construction, `process` does not allocate.
+  class InputPipeline {
+    public:
+      inline static constexpr const size_t CHANNEL_COUNT = GloveStateTable::FINGER_COUNT * GloveStateTable::JOINT_COUNT // curl
+                                                           + GloveStateTable::FINGER_COUNT                            // splay
+                                                           + 2                                                        // joystick
+                                                           + GloveStateTable::ANALOG_BUTTON_COUNT;
+
+      InputPipeline(size_t glove_count, const InputPipelineConfig& config);
+
+      [[nodiscard]] auto size() const -> size_t { return this->glove_count_; }
+
+      /// While calibrating, the observed range of every channel is recorded.
+      auto startCalibration() -> void { this->calibrating_ = true; }
+      auto stopCalibration() -> void { this->calibrating_ = false; }
+      auto resetCalibration() -> void;
+      [[nodiscard]] auto isCalibrating() const -> bool { return this->calibrating_; }
+
+      /// Process every glove of the table in place.
+      /// `table` must have the same size as the pipeline, `dt` is the time since the previous frame, in seconds.
+      auto process(GloveStateTable& table, float dt) -> void;
+
+      /// Process a single glove in place.
+      /// \return `false` if `glove` is out of range, `input` is left untouched then.
+      auto process(InputPeripheralData& input, float dt, size_t glove = 0) -> bool;
+
+    private:
+      InputPipelineConfig config_;
+      size_t glove_count_;
+      size_t stride_;
+      bool calibrating_ = false;
+
+      /// Per channel and per glove, laid out as `channel * stride_ + glove`
+      std::vector<float> min_;
+      std::vector<float> max_;
+      std::vector<float> state_;
+      std::vector<float> derivative_;
+      std::vector<std::uint8_t> initialized_;
+
+      [[nodiscard]] auto channelConfig(size_t channel) const -> const ChannelConfig&;
+      static auto channel(GloveStateTable& table, size_t channel) -> float*;
+      static auto channel(InputPeripheralData& input, size_t channel) -> float*;
+
+      auto processChannel(size_t channel, float* values, size_t offset, size_t count, float dt) -> void;
+  };
+
+  inline InputPipeline::InputPipeline(size_t glove_count, const InputPipelineConfig& config) :
+    config_(config),
+    glove_count_(glove_count),
+    stride_((glove_count + GloveStateTable::COLUMN_ALIGNMENT - 1) / GloveStateTable::COLUMN_ALIGNMENT * GloveStateTable::COLUMN_ALIGNMENT),
+    min_(CHANNEL_COUNT * stride_),
+    max_(CHANNEL_COUNT * stride_),
+    state_(CHANNEL_COUNT * stride_, 0.0F),
+    derivative_(CHANNEL_COUNT * stride_, 0.0F),
+    initialized_(CHANNEL_COUNT * stride_, 0)
+  {
+    this->resetCalibration();
+  }
+
+  inline auto InputPipeline::resetCalibration() -> void {
+    // An inverted range is treated as "not calibrated yet" and passes values through
+    std::fill(this->min_.begin(), this->min_.end(), 1.0F);
+    std::fill(this->max_.begin(), this->max_.end(), 0.0F);
+  }
+
+  inline auto InputPipeline::channelConfig(size_t channel) const -> const ChannelConfig& {
+    constexpr const auto CURL_CHANNELS = GloveStateTable::FINGER_COUNT * GloveStateTable::JOINT_COUNT;
+    constexpr const auto SPLAY_CHANNELS = CURL_CHANNELS + GloveStateTable::FINGER_COUNT;
+
+    if (channel < CURL_CHANNELS) {
+      return this->config_.curl.fingers[channel / GloveStateTable::JOINT_COUNT].curl[channel % GloveStateTable::JOINT_COUNT];
+    }
+    if (channel < SPLAY_CHANNELS) {
+      return this->config_.splay.fingers[channel - CURL_CHANNELS];
+    }
+    if (channel < SPLAY_CHANNELS + 2) {
+      return this->config_.joystick;
+    }
+    return this->config_.analog_buttons;
+  }
+
+  inline auto InputPipeline::channel(GloveStateTable& table, size_t channel) -> float* {
+    constexpr const auto CURL_CHANNELS = GloveStateTable::FINGER_COUNT * GloveStateTable::JOINT_COUNT;
+    constexpr const auto SPLAY_CHANNELS = CURL_CHANNELS + GloveStateTable::FINGER_COUNT;
+
+    if (channel < CURL_CHANNELS) {
+      return table.curl(channel / GloveStateTable::JOINT_COUNT, channel % GloveStateTable::JOINT_COUNT);
+    }
+    if (channel < SPLAY_CHANNELS) {
+      return table.splay(channel - CURL_CHANNELS);
+    }
+    if (channel == SPLAY_CHANNELS) {
+      return table.joystickX();
+    }
+    if (channel == SPLAY_CHANNELS + 1) {
+      return table.joystickY();
+    }
+    return table.analogButtonValue(channel - SPLAY_CHANNELS - 2);
+  }
+
+  inline auto InputPipeline::channel(InputPeripheralData& input, size_t channel) -> float* {
+    constexpr const auto CURL_CHANNELS = GloveStateTable::FINGER_COUNT * GloveStateTable::JOINT_COUNT;
+    constexpr const auto SPLAY_CHANNELS = CURL_CHANNELS + GloveStateTable::FINGER_COUNT;
+
+    if (channel < CURL_CHANNELS) {
+      return &input.curl.fingers[channel / GloveStateTable::JOINT_COUNT].curl[channel % GloveStateTable::JOINT_COUNT];
+    }
+    if (channel < SPLAY_CHANNELS) {
+      return &input.splay.fingers[channel - CURL_CHANNELS];
+    }
+    if (channel == SPLAY_CHANNELS) {
+      return &input.joystick.x;
+    }
+    if (channel == SPLAY_CHANNELS + 1) {
+      return &input.joystick.y;
+    }
+    return &input.analog_buttons[channel - SPLAY_CHANNELS - 2].value;
+  }
+
+  inline auto InputPipeline::process(GloveStateTable& table, float dt) -> void {
+    const auto count = std::min(table.size(), this->glove_count_);
+
+    for (size_t channel = 0; channel < CHANNEL_COUNT; channel++) {
+      this->processChannel(channel, InputPipeline::channel(table, channel), 0, count, dt);
+    }
+  }
+
+  inline auto InputPipeline::process(InputPeripheralData& input, float dt, size_t glove) -> bool {
+    if (glove >= this->glove_count_) {
+      return false;
+    }
+
+    for (size_t channel = 0; channel < CHANNEL_COUNT; channel++) {
+      this->processChannel(channel, InputPipeline::channel(input, channel), glove, 1, dt);
+    }
+    return true;
+  }
+
+  inline auto InputPipeline::processChannel(size_t channel, float* values, size_t offset, size_t count, float dt) -> void {
+    const auto& config = this->channelConfig(channel);
+    const auto base = channel * this->stride_ + offset;
+
+    if (config.calibrate) {
+      if (this->calibrating_) {
+        kernels::trackRange(values, &this->min_[base], &this->max_[base], count);
+      }
+      kernels::mapRange(values, &this->min_[base], &this->max_[base], count);
+      kernels::clamp(values, 0.0F, 1.0F, count);
+    }
+
+    if (config.deadzone > 0.0F) {
+      kernels::deadzone(values, config.deadzone, count);
+    }
+
+    if (config.filter == FilterType_None) {
+      return;
+    }
+
+    // Seed the filter state with the first frame of every glove, so filters do not ramp up from zero
+    for (size_t i = 0; i < count; i++) {
+      if (this->initialized_[base + i] == 0) {
+        this->state_[base + i] = values[i];
+        this->initialized_[base + i] = 1;
+      }
+    }
+
+    switch (config.filter) {
+      case FilterType_Ema:
+        kernels::ema(values, &this->state_[base], config.ema_alpha, count);
+        break;
+      case FilterType_OneEuro:
+        kernels::oneEuro(
+          values,
+          &this->state_[base],
+          &this->derivative_[base],
+          config.one_euro_min_cutoff,
+          config.one_euro_beta,
+          config.one_euro_derivative_cutoff,
+          dt,
+          count
+        );
+        break;
+      default:
+        break;
+    }
+  }
+} // namespace opengloves
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <opengloves.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace opengloves {
+  /// Fixed-size ring buffer of timestamped input frames, newest last.
+  template<size_t Capacity>
+  class InputHistory {
+      static_assert(Capacity >= 2, "History needs at least two frames to estimate velocity");
+
+    public:
+      struct Entry {
+        Timestamp timestamp;
+        InputPeripheralData input;
+      };
+
+      auto push(Timestamp timestamp, const InputPeripheralData& input) -> void {
+        this->head_ = (this->head_ + 1) % Capacity;
+        this->entries_[this->head_] = { timestamp, input };
+        this->size_ = std::min(this->size_ + 1, Capacity);
+      }
+
+      auto clear() -> void { this->size_ = 0; }
+
+      [[nodiscard]] auto size() const -> size_t { return this->size_; }
+      [[nodiscard]] auto empty() const -> bool { return this->size_ == 0; }
+      [[nodiscard]] static constexpr auto capacity() -> size_t { return Capacity; }
+
+      /// Access entries by age, `0` being the newest one.
+      [[nodiscard]] auto fromNewest(size_t age) const -> const Entry& {
+        return this->entries_[(this->head_ + Capacity - age) % Capacity];
+      }
+
+      [[nodiscard]] auto newest() const -> const Entry& { return this->fromNewest(0); }
+      [[nodiscard]] auto oldest() const -> const Entry& { return this->fromNewest(this->size_ - 1); }
+
+    private:
+      std::array<Entry, Capacity> entries_{};
+      size_t head_ = Capacity - 1;
+      size_t size_ = 0;
+  };
+
+  using PredictionModeIndex = std::uint8_t;
+  enum PredictionMode : PredictionModeIndex {
+    /// Return the newest frame as is.
+    PredictionMode_Hold = 0,
+
+    /// Extrapolate along the current velocity.
+    PredictionMode_Linear,
+
+    /// Extrapolate along a velocity that decays with `damping_time`, so long extrapolations level off
+    /// instead of overshooting.
+    PredictionMode_VelocityDamped,
+  };
+
+  struct PredictionConfig {
+    PredictionMode mode = PredictionMode_VelocityDamped;
+
+    /// Time constant of the velocity decay, in microseconds; `0` or less holds the newest frame.
+    float damping_time = 30'000.0F; // NOLINT(*-magic-numbers)
+
+    /// Extrapolation never goes further than this past the newest frame, in microseconds.
+    Timestamp max_horizon = 50'000; // NOLINT(*-magic-numbers)
+  };
+
+  /// Predicts the analog channels of a glove (curl, splay, joystick, analog buttons) at an arbitrary time,
+  /// so the state can be sampled at render time instead of at the (stale) arrival time of the last frame.
+  /// Digital channels are always taken from the newest frame.
+  ///
+  /// Velocity is estimated over the whole history when a frame is pushed, so `predict` is O(1).
+  template<size_t HistorySize = 4>
+  class InputPredictor {
+    public:
+      inline static constexpr const size_t ANALOG_CHANNEL_COUNT = 5 * 4 + 5 + 2 + 2; // NOLINT(*-magic-numbers)
+
+      explicit InputPredictor(const PredictionConfig& config = {}) : config_(config) {}
+
+      [[nodiscard]] auto config() const -> const PredictionConfig& { return this->config_; }
+      auto setConfig(const PredictionConfig& config) -> void { this->config_ = config; }
+
+      [[nodiscard]] auto history() const -> const InputHistory<HistorySize>& { return this->history_; }
+
+      auto reset() -> void {
+        this->history_.clear();
+        this->velocity_.fill(0.0F);
+      }
+
+      /// Record a frame. Frames older than the newest one are dropped.
+      auto push(Timestamp timestamp, const InputPeripheralData& input) -> void;
+
+      /// State of the glove at `timestamp`.
+      /// Times between the two newest frames are interpolated, later times are extrapolated.
+      [[nodiscard]] auto predict(Timestamp timestamp) const -> InputPeripheralData;
+
+    private:
+      PredictionConfig config_;
+      InputHistory<HistorySize> history_;
+
+      /// Per analog channel, in units per microsecond
+      std::array<float, ANALOG_CHANNEL_COUNT> velocity_{};
+
+      /// Call `fn(index, first_value, second_value)` for every analog channel of both frames.
+      template<typename TFirst, typename TSecond, typename Fn>
+      static auto forEachAnalog(TFirst& first, TSecond& second, Fn&& fn) -> void;
+  };
+
+  template<size_t HistorySize>
+  template<typename TFirst, typename TSecond, typename Fn>
+  inline auto InputPredictor<HistorySize>::forEachAnalog(TFirst& first, TSecond& second, Fn&& fn) -> void {
+    size_t index = 0;
+
+    for (size_t finger = 0; finger < first.curl.fingers.size(); finger++) {
+      for (size_t joint = 0; joint < first.curl.fingers[finger].curl.size(); joint++) {
+        fn(index++, first.curl.fingers[finger].curl[joint], second.curl.fingers[finger].curl[joint]);
+      }
+      fn(index++, first.splay.fingers[finger], second.splay.fingers[finger]);
+    }
+
+    fn(index++, first.joystick.x, second.joystick.x);
+    fn(index++, first.joystick.y, second.joystick.y);
+
+    for (size_t i = 0; i < first.analog_buttons.size(); i++) {
+      fn(index++, first.analog_buttons[i].value, second.analog_buttons[i].value);
+    }
+  }
+
+  template<size_t HistorySize>
+  inline auto InputPredictor<HistorySize>::push(Timestamp timestamp, const InputPeripheralData& input) -> void {
+    if (!this->history_.empty() && elapsed(this->history_.newest().timestamp, timestamp) <= 0) {
+      return;
+    }
+
+    this->history_.push(timestamp, input);
+
+    if (this->history_.size() < 2) {
+      this->velocity_.fill(0.0F);
+      return;
+    }
+
+    // Slope over the whole window is less noisy than the last two frames, at the cost of some lag
+    const auto& oldest = this->history_.oldest();
+    const auto inverse_span = 1.0F / static_cast<float>(elapsed(oldest.timestamp, timestamp));
+
+    InputPredictor::forEachAnalog(input, oldest.input, [this, inverse_span](size_t index, const float& newest, const float& old) {
+      this->velocity_[index] = (newest - old) * inverse_span;
+    });
+  }
+
+  template<size_t HistorySize>
+  inline auto InputPredictor<HistorySize>::predict(Timestamp timestamp) const -> InputPeripheralData {
+    if (this->history_.empty()) {
+      return {};
+    }
+
+    const auto& newest = this->history_.newest();
+    InputPeripheralData output = newest.input;
+
+    if (this->config_.mode == PredictionMode_Hold) {
+      return output;
+    }
+
+    const auto dt = elapsed(newest.timestamp, timestamp);
+
+    if (dt < 0) {
+      if (this->history_.size() < 2) {
+        return output;
+      }
+
+      // Interpolate between the two newest frames
+      const auto& previous = this->history_.fromNewest(1);
+      const auto span = elapsed(previous.timestamp, newest.timestamp);
+      const auto t = std::max(0.0F, 1.0F + static_cast<float>(dt) / static_cast<float>(span));
+
+      InputPredictor::forEachAnalog(output, previous.input, [t](size_t /*index*/, float& value, const float& old) {
+        value = old + (value - old) * t;
+      });
+
+      return output;
+    }
+
+    const auto horizon = static_cast<float>(std::min(static_cast<Timestamp>(dt), this->config_.max_horizon));
+    const auto damping_time = this->config_.damping_time;
+
+    // Without damping time the velocity decays at once, the limit of the formula; `0 / 0` would be NaN
+    auto travel = horizon;
+    if (this->config_.mode == PredictionMode_VelocityDamped) {
+      travel = damping_time > 0.0F ? damping_time * (1.0F - std::exp(-horizon / damping_time)) : 0.0F;
+    }
+
+    const auto& velocity = this->velocity_;
+    InputPredictor::forEachAnalog(output, newest.input, [&velocity, travel](size_t index, float& value, const float& /*unused*/) {
+      value = std::min(std::max(value + velocity[index] * travel, 0.0F), 1.0F);
+    });
+
+    return output;
+  }
+} // namespace opengloves
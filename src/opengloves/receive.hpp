@@ -0,0 +1,183 @@
+#pragma once
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace opengloves {
+  /// The newest complete frame of a receive buffer.
+  struct LatestFrame {
+    /// Points into the buffer, `nullptr` if there is no complete frame.
+    const uint8_t* data;
+    /// Including the line break.
+    size_t size;
+
+    /// Complete frames before the newest one, that are skipped.
+    size_t dropped;
+
+    /// Bytes up to and including the newest frame; anything after it is an incomplete frame to keep for later.
+    size_t consumed;
+  };
+
+  /// Find the newest complete frame of a buffer with many queued frames, scanning backwards from the end.
+  /// Empty lines are not frames.
+  inline auto findLatestFrame(const uint8_t* buffer, size_t buffer_size) -> LatestFrame {
+    LatestFrame latest{ nullptr, 0, 0, 0 };
+
+    size_t end = buffer_size;
+    while (end > 0 && buffer[end - 1] != '\n') {
+      end--;
+    }
+    latest.consumed = end;
+
+    // Skip empty lines at the end
+    while (end > 0 && buffer[end - 1] == '\n') {
+      end--;
+    }
+    if (end == 0) {
+      return latest;
+    }
+
+    size_t begin = end;
+    while (begin > 0 && buffer[begin - 1] != '\n') {
+      begin--;
+    }
+
+    latest.data = buffer + begin;
+    latest.size = end - begin + 1;
+
+    // Counting is the only forward pass, memchr keeps it far cheaper than decoding what it skips
+    for (const auto* line = buffer; line < buffer + begin;) {
+      const auto* newline = static_cast<const uint8_t*>(std::memchr(line, '\n', static_cast<size_t>(buffer + begin - line)));
+      if (newline != line) {
+        latest.dropped++;
+      }
+      line = newline + 1;
+    }
+
+    return latest;
+  }
+
+  template<typename T>
+  struct LatestDecoded {
+    T value;
+
+    /// See `LatestFrame`.
+    size_t dropped;
+    size_t consumed;
+  };
+
+  /// Decodes only the newest frame of a backlog, as only the newest state matters to a receiver that fell behind.
+  template<typename Encoding = AlphaEncoding>
+  class LatestFrameDecoder {
+    public:
+      /// Decode the newest input frame; input frames are full snapshots, so there is nothing to merge.
+      static auto decodeInput(const uint8_t* buffer, size_t buffer_size) -> LatestDecoded<InputData>;
+
+      /// Decode the newest output frame.
+      ///
+      /// With `merge`, fields the newest frame leaves out (e.g. a force feedback frame with only some fingers) are
+      /// taken from the newest skipped frame of the same kind that has them.
+      static auto decodeOutput(const uint8_t* buffer, size_t buffer_size, bool merge = false) -> LatestDecoded<OutputData>;
+
+    private:
+      /// Bit `i` is set if single-letter key `first + i` is in the frame
+      static auto keyMask(const uint8_t* frame, size_t frame_size, char first, char last) -> std::uint8_t;
+
+      /// Fill the fields of `value` missing from the newest frame from the skipped ones.
+      /// Field `i` is `field(value, i)`, and has the key `first_key + i`.
+      template<size_t N, typename T, typename Field>
+      static auto mergeOlder(const uint8_t* buffer, const LatestFrame& latest, char first_key, T& value, Field&& field) -> void;
+  };
+
+  template<typename Encoding>
+  inline auto LatestFrameDecoder<Encoding>::decodeInput(const uint8_t* buffer, size_t buffer_size) -> LatestDecoded<InputData> {
+    const auto latest = findLatestFrame(buffer, buffer_size);
+    if (latest.data == nullptr) {
+      return { InputInvalid{}, latest.dropped, latest.consumed };
+    }
+
+    return { Encoding::decodeInput(latest.data, latest.size), latest.dropped, latest.consumed };
+  }
+
+  template<typename Encoding>
+  inline auto LatestFrameDecoder<Encoding>::decodeOutput(const uint8_t* buffer, size_t buffer_size, bool merge) -> LatestDecoded<OutputData> {
+    const auto latest = findLatestFrame(buffer, buffer_size);
+    if (latest.data == nullptr) {
+      return { OutputInvalid{}, latest.dropped, latest.consumed };
+    }
+
+    LatestDecoded<OutputData> result{ Encoding::decodeOutput(latest.data, latest.size), latest.dropped, latest.consumed };
+    if (!merge || latest.dropped == 0) {
+      return result;
+    }
+
+    if (auto* ffb = std::get_if<OutputForceFeedbackData>(&result.value)) {
+      LatestFrameDecoder::mergeOlder<5>(buffer, latest, 'A', *ffb, [](auto& data, size_t i) -> auto& { return data.fingers[i]; });
+    } else if (auto* haptics = std::get_if<OutputHapticsData>(&result.value)) {
+      LatestFrameDecoder::mergeOlder<3>(buffer, latest, 'F', *haptics, [](auto& data, size_t i) -> auto& {
+        return i == 0 ? data.frequency : (i == 1 ? data.duration : data.amplitude);
+      });
+    }
+
+    return result;
+  }
+
+  template<typename Encoding>
+  inline auto LatestFrameDecoder<Encoding>::keyMask(const uint8_t* frame, size_t frame_size, char first, char last) -> std::uint8_t {
+    std::uint8_t mask = 0;
+
+    Encoding::forEachPair(reinterpret_cast<const char*>(frame), frame_size, [&](std::string_view key, std::string_view value) {
+      if (key.size() == 1 && key[0] >= first && key[0] <= last && !value.empty()) {
+        mask |= static_cast<std::uint8_t>(1U << static_cast<unsigned>(key[0] - first));
+      }
+    });
+
+    return mask;
+  }
+
+  template<typename Encoding>
+  template<size_t N, typename T, typename Field>
+  inline auto LatestFrameDecoder<Encoding>::mergeOlder(const uint8_t* buffer, const LatestFrame& latest, char first_key, T& value, Field&& field) -> void {
+    constexpr auto ALL = static_cast<std::uint8_t>((1U << N) - 1);
+    const auto last_key = static_cast<char>(first_key + N - 1);
+
+    auto seen = LatestFrameDecoder::keyMask(latest.data, latest.size, first_key, last_key);
+
+    // Walk the skipped frames from newest to oldest, until every field is known
+    size_t end = static_cast<size_t>(latest.data - buffer);
+    while (seen != ALL && end > 0) {
+      size_t begin = end - 1;
+      while (begin > 0 && buffer[begin - 1] != '\n') {
+        begin--;
+      }
+
+      const auto* frame = buffer + begin;
+      const auto frame_size = end - begin;
+      end = begin;
+
+      const auto mask = LatestFrameDecoder::keyMask(frame, frame_size, first_key, last_key);
+      const auto missing = static_cast<std::uint8_t>(mask & ~seen);
+      if (missing == 0) {
+        continue;
+      }
+
+      const auto older = Encoding::decodeOutput(frame, frame_size);
+      const auto* older_value = std::get_if<T>(&older);
+      if (older_value == nullptr) {
+        continue;
+      }
+
+      for (size_t i = 0; i < N; i++) {
+        if ((missing & (1U << i)) != 0) {
+          field(value, i) = field(*older_value, i);
+        }
+      }
+      seen |= missing;
+    }
+  }
+} // namespace opengloves
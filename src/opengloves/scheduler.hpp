@@ -0,0 +1,115 @@
+#pragma once
+
+#include <opengloves.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace opengloves {
+  struct FrameSchedulerConfig {
+    /// Keep-alive rate at rest, in Hz.
+    std::uint16_t min_rate = 10; // NOLINT(*-magic-numbers)
+
+    /// Rate during fast motion, in Hz.
+    std::uint16_t max_rate = 200; // NOLINT(*-magic-numbers)
+
+    /// Velocity of the fastest channel, in units per second, at which `max_rate` is reached; `0` or less sends any
+    /// motion above `noise` at `max_rate`.
+    float full_rate_velocity = 2.0F; // NOLINT(*-magic-numbers)
+
+    /// Changes smaller than this are treated as sensor noise.
+    float noise = 0.002F; // NOLINT(*-magic-numbers)
+  };
+
+  /// Decides when the glove sends an input frame: at `max_rate` while any channel moves fast, slowing down to the
+  /// `min_rate` keep-alive at rest. Digital channels (buttons) are sent as soon as `max_rate` allows.
+  ///
+  /// The rate follows the fastest channel, measured as its change since the last sent frame over the time since.
+  /// A change of `full_rate_velocity / (max_rate - min_rate)` is sent right away, smaller changes wait at most until
+  /// the keep-alive, sooner the larger they are.
+  class FrameScheduler {
+    public:
+      explicit FrameScheduler(const FrameSchedulerConfig& config = {}) : config_(config) {}
+
+      [[nodiscard]] auto config() const -> const FrameSchedulerConfig& { return this->config_; }
+
+      /// Whether `input` should be sent at `now`; if so, it is remembered as the last sent frame.
+      auto poll(Timestamp now, const InputPeripheralData& input) -> bool;
+
+      /// Forget the last sent frame, the next poll sends.
+      auto reset() -> void { this->has_sent_ = false; }
+
+      /// Timestamp of the last sent frame, only meaningful after the first one.
+      [[nodiscard]] auto lastSent() const -> Timestamp { return this->last_sent_time_; }
+
+    private:
+      FrameSchedulerConfig config_;
+
+      bool has_sent_ = false;
+      Timestamp last_sent_time_ = 0;
+      InputPeripheralData last_sent_;
+
+      /// Largest change of an analog channel, and whether any digital channel changed, since the last sent frame.
+      auto compare(const InputPeripheralData& input, bool& digital_changed) const -> float;
+  };
+
+  inline auto FrameScheduler::compare(const InputPeripheralData& input, bool& digital_changed) const -> float {
+    const auto& sent = this->last_sent_;
+    float deviation = 0.0F;
+    const auto analog = [&deviation](float value, float previous) { deviation = std::max(deviation, std::abs(value - previous)); };
+    const auto digital = [&digital_changed](bool value, bool previous) { digital_changed = digital_changed || value != previous; };
+
+    for (size_t finger = 0; finger < input.curl.fingers.size(); finger++) {
+      for (size_t joint = 0; joint < input.curl.fingers[finger].curl.size(); joint++) {
+        analog(input.curl.fingers[finger].curl[joint], sent.curl.fingers[finger].curl[joint]);
+      }
+      analog(input.splay.fingers[finger], sent.splay.fingers[finger]);
+    }
+
+    analog(input.joystick.x, sent.joystick.x);
+    analog(input.joystick.y, sent.joystick.y);
+    digital(input.joystick.press, sent.joystick.press);
+
+    for (size_t i = 0; i < input.buttons.size(); i++) {
+      digital(input.buttons[i].press, sent.buttons[i].press);
+    }
+
+    for (size_t i = 0; i < input.analog_buttons.size(); i++) {
+      analog(input.analog_buttons[i].value, sent.analog_buttons[i].value);
+      digital(input.analog_buttons[i].press, sent.analog_buttons[i].press);
+    }
+
+    return deviation;
+  }
+
+  inline auto FrameScheduler::poll(Timestamp now, const InputPeripheralData& input) -> bool {
+    bool send = !this->has_sent_;
+
+    if (!send) {
+      const auto since = static_cast<float>(std::max<std::int32_t>(elapsed(this->last_sent_time_, now), 0));
+      const auto min_rate = static_cast<float>(this->config_.min_rate);
+      const auto max_rate = static_cast<float>(std::max(this->config_.max_rate, this->config_.min_rate));
+
+      if (since * max_rate >= 1e6F) {
+        bool digital_changed = false;
+        const auto deviation = std::max(this->compare(input, digital_changed) - this->config_.noise, 0.0F);
+
+        // Due once `since >= 1 / rate`, with `rate = min_rate + (max_rate - min_rate) * velocity / full_rate_velocity`
+        // and `velocity = deviation / since`; multiplied out, so a zero `since` or velocity needs no special case
+        const auto full_rate_velocity = this->config_.full_rate_velocity;
+        const auto motion = full_rate_velocity > 0.0F ? (max_rate - min_rate) * deviation / full_rate_velocity : (deviation > 0.0F ? 1.0F : 0.0F);
+        const auto credit = since * 1e-6F * min_rate + motion;
+        send = digital_changed || credit >= 1.0F;
+      }
+    }
+
+    if (send) {
+      this->has_sent_ = true;
+      this->last_sent_time_ = now;
+      this->last_sent_ = input;
+    }
+
+    return send;
+  }
+} // namespace opengloves
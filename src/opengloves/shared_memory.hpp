@@ -0,0 +1,313 @@
+#pragma once
+
+#include <opengloves.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if __has_include(<sys/mman.h>) && __has_include(<linux/futex.h>)
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#define OPENGLOVES_HAS_SHARED_MEMORY
+#endif
+
+#ifdef OPENGLOVES_HAS_SHARED_MEMORY
+
+namespace opengloves {
+  /// Latest value of a trivially copyable type, written by a single writer and read by any number of readers
+  /// without locks or syscalls.
+  ///
+  /// The sequence number is odd while a write is in progress; readers retry until they copied the value between
+  /// two reads of the same, even, sequence number.
+  template<typename T>
+  struct alignas(64) SeqlockSlot { // NOLINT(*-magic-numbers): keep slots on separate cache lines
+    static_assert(std::is_trivially_copyable_v<T>, "Slots are copied byte-wise");
+
+    std::atomic<std::uint32_t> sequence;
+    T value;
+
+    auto store(const T& data) -> void {
+      const auto current = this->sequence.load(std::memory_order_relaxed);
+      this->sequence.store(current + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+
+      std::memcpy(static_cast<void*>(&this->value), &data, sizeof(T));
+
+      this->sequence.store(current + 2, std::memory_order_release);
+    }
+
+    /// \return The sequence number of the copied value, `0` if nothing was stored yet.
+    auto load(T& data) const -> std::uint32_t {
+      while (true) {
+        const auto before = this->sequence.load(std::memory_order_acquire);
+        if ((before & 1U) != 0) {
+          continue;
+        }
+
+        std::memcpy(static_cast<void*>(&data), &this->value, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (this->sequence.load(std::memory_order_relaxed) == before) {
+          return before;
+        }
+      }
+    }
+  };
+
+  /// Per-glove input and output state in a POSIX shared memory segment, for hosts where several processes
+  /// (e.g. a serial bridge, a VR driver and a recorder) consume the same decoded gloves.
+  ///
+  /// One process creates the segment and publishes; any number of processes open it and read the latest state
+  /// straight from the mapping. Reads never enter the kernel; `wait` sleeps on a futex until the next publish, and
+  /// publishing only wakes the kernel while someone waits.
+  ///
+  /// A publisher that restarts creates a fresh segment under the same name, and retires the old one: it is marked
+  /// stale and its waiters are woken. Readers check `stale()` after every `wait` (or now and then, if they poll),
+  /// and `open` the name again once it is.
+  class SharedGloveState {
+    public:
+      inline static constexpr const std::uint32_t MAGIC = 0x4F47'5348; // "OGSH"
+      inline static constexpr const std::uint32_t VERSION = 1;
+
+      SharedGloveState() = default;
+      ~SharedGloveState() { this->close(); }
+
+      SharedGloveState(const SharedGloveState&) = delete;
+      auto operator=(const SharedGloveState&) -> SharedGloveState& = delete;
+
+      /// Create the segment `name` (retiring an existing one), e.g. `/opengloves`, with room for `glove_count` gloves.
+      /// \return `false` if the segment could not be created or mapped.
+      auto create(const char* name, std::uint32_t glove_count) -> bool;
+
+      /// Open a segment created by another process.
+      /// \return `false` if it does not exist, or was created by an incompatible version.
+      auto open(const char* name) -> bool;
+
+      auto close() -> void;
+
+      /// Remove the segment name; processes that have it open keep their mapping.
+      static auto unlink(const char* name) -> void { shm_unlink(name); }
+
+      [[nodiscard]] auto isOpen() const -> bool { return this->segment_ != nullptr; }
+      [[nodiscard]] auto gloveCount() const -> std::uint32_t { return this->segment_ == nullptr ? 0 : this->segment_->glove_count; }
+
+      /// Whether the segment was replaced by a newer one (or is not open), and should be opened again.
+      [[nodiscard]] auto stale() const -> bool {
+        return this->segment_ == nullptr || this->segment_->magic.load(std::memory_order_acquire) != MAGIC;
+      }
+
+      /// \return `false` if the state is not open, or `glove` is out of range.
+      auto publish(std::uint32_t glove, const InputPeripheralData& input) -> bool {
+        if (glove >= this->gloveCount()) {
+          return false;
+        }
+        this->slots()[glove].input.store(input);
+        this->notify();
+        return true;
+      }
+
+      auto publish(std::uint32_t glove, const OutputData& output) -> bool {
+        if (glove >= this->gloveCount()) {
+          return false;
+        }
+        this->slots()[glove].output.store(output);
+        this->notify();
+        return true;
+      }
+
+      /// \return The sequence number of the state, it changes with every publish; `0` if nothing was published,
+      /// the state is not open, or `glove` is out of range.
+      auto read(std::uint32_t glove, InputPeripheralData& input) const -> std::uint32_t {
+        return glove < this->gloveCount() ? this->slots()[glove].input.load(input) : 0;
+      }
+      auto read(std::uint32_t glove, OutputData& output) const -> std::uint32_t {
+        return glove < this->gloveCount() ? this->slots()[glove].output.load(output) : 0;
+      }
+
+      /// Counter of publishes to any glove, `0` if the state is not open.
+      [[nodiscard]] auto generation() const -> std::uint32_t {
+        return this->segment_ == nullptr ? 0 : this->segment_->generation.load(std::memory_order_acquire);
+      }
+
+      /// Sleep until `generation()` differs from `seen`, or `timeout` microseconds have passed.
+      /// \return `true` if there was a publish, or the segment was retired; `false` on timeout, or if not open.
+      auto wait(std::uint32_t seen, std::uint32_t timeout) -> bool;
+
+    private:
+      struct Slots {
+        SeqlockSlot<InputPeripheralData> input;
+        SeqlockSlot<OutputData> output;
+      };
+
+      struct Segment {
+        /// Set last, once the rest of the header is valid
+        std::atomic<std::uint32_t> magic;
+        std::uint32_t version;
+        std::uint32_t glove_count;
+        std::uint32_t slots_size;
+
+        /// Futex word
+        std::atomic<std::uint32_t> generation;
+        std::atomic<std::uint32_t> waiters;
+      };
+
+      static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "Futexes need plain 32-bit words");
+      static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "Futexes need plain 32-bit words");
+
+      Segment* segment_ = nullptr;
+      size_t size_ = 0;
+
+      static auto slotsOffset() -> size_t { return (sizeof(Segment) + alignof(Slots) - 1) / alignof(Slots) * alignof(Slots); }
+      static auto segmentSize(std::uint32_t glove_count) -> size_t { return slotsOffset() + sizeof(Slots) * glove_count; }
+
+      auto slots() const -> Slots* {
+        return reinterpret_cast<Slots*>(reinterpret_cast<std::uint8_t*>(this->segment_) + slotsOffset());
+      }
+
+      auto map(int fd, size_t size) -> bool;
+      auto notify() -> void;
+
+      /// Mark an existing segment `name` stale, and wake its waiters.
+      static auto retire(const char* name) -> void;
+  };
+
+  inline auto SharedGloveState::map(int fd, size_t size) -> bool {
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) { // NOLINT(*-cstyle-cast)
+      return false;
+    }
+
+    this->segment_ = static_cast<Segment*>(mapping);
+    this->size_ = size;
+    return true;
+  }
+
+  inline auto SharedGloveState::create(const char* name, std::uint32_t glove_count) -> bool {
+    this->close();
+
+    // Never truncate a segment other processes may still have mapped, give them a fresh one instead
+    SharedGloveState::retire(name);
+    shm_unlink(name);
+    const int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR); // NOLINT(*-signed-bitwise)
+    if (fd < 0) {
+      return false;
+    }
+
+    const auto size = SharedGloveState::segmentSize(glove_count);
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+      ::close(fd);
+      return false;
+    }
+
+    if (!this->map(fd, size)) {
+      return false;
+    }
+
+    // ftruncate() zero-fills: every sequence number and counter starts at 0
+    this->segment_->version = VERSION;
+    this->segment_->glove_count = glove_count;
+    this->segment_->slots_size = sizeof(Slots);
+    this->segment_->magic.store(MAGIC, std::memory_order_release);
+
+    return true;
+  }
+
+  inline auto SharedGloveState::retire(const char* name) -> void {
+    SharedGloveState old;
+    if (!old.open(name)) {
+      return;
+    }
+
+    old.segment_->magic.store(0, std::memory_order_release);
+    old.notify();
+  }
+
+  inline auto SharedGloveState::open(const char* name) -> bool {
+    this->close();
+
+    const int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+      return false;
+    }
+
+    struct stat status{};
+    if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(Segment)) {
+      ::close(fd);
+      return false;
+    }
+
+    if (!this->map(fd, static_cast<size_t>(status.st_size))) {
+      return false;
+    }
+
+    if (this->segment_->magic.load(std::memory_order_acquire) != MAGIC || this->segment_->version != VERSION || this->segment_->slots_size != sizeof(Slots)
+        || this->size_ < SharedGloveState::segmentSize(this->segment_->glove_count)) {
+      this->close();
+      return false;
+    }
+
+    return true;
+  }
+
+  inline auto SharedGloveState::close() -> void {
+    if (this->segment_ != nullptr) {
+      munmap(this->segment_, this->size_);
+    }
+    this->segment_ = nullptr;
+    this->size_ = 0;
+  }
+
+  inline auto SharedGloveState::notify() -> void {
+    // Sequentially consistent on both ends: either the waiter sees the new generation, or we see the waiter
+    this->segment_->generation.fetch_add(1, std::memory_order_seq_cst);
+
+    if (this->segment_->waiters.load(std::memory_order_seq_cst) != 0) {
+      syscall(SYS_futex, &this->segment_->generation, FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0); // NOLINT(*-vararg)
+    }
+  }
+
+  inline auto SharedGloveState::wait(std::uint32_t seen, std::uint32_t timeout) -> bool {
+    if (this->segment_ == nullptr) {
+      return false;
+    }
+
+    auto& generation = this->segment_->generation;
+
+    timespec deadline{};
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += static_cast<time_t>(timeout / 1'000'000U);
+    deadline.tv_nsec += static_cast<long>(timeout % 1'000'000U) * 1'000L;
+    if (deadline.tv_nsec >= 1'000'000'000L) {
+      deadline.tv_sec++;
+      deadline.tv_nsec -= 1'000'000'000L;
+    }
+
+    this->segment_->waiters.fetch_add(1, std::memory_order_seq_cst);
+
+    while (generation.load(std::memory_order_seq_cst) == seen) {
+      // FUTEX_WAIT_BITSET takes an absolute deadline, so spurious wake-ups do not extend the timeout
+      const auto result = syscall(
+          SYS_futex, &generation, FUTEX_WAIT_BITSET, seen, &deadline, nullptr, FUTEX_BITSET_MATCH_ANY
+      ); // NOLINT(*-vararg)
+      if (result != 0 && errno == ETIMEDOUT) {
+        break;
+      }
+    }
+
+    this->segment_->waiters.fetch_sub(1, std::memory_order_seq_cst);
+
+    return generation.load(std::memory_order_acquire) != seen;
+  }
+} // namespace opengloves
+
+#endif
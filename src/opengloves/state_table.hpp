@@ -0,0 +1,184 @@
+#pragma once
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace opengloves {
+  /// Input state of many gloves, stored as structure-of-arrays.
+  ///
+  /// Every channel (e.g. curl of the index finger's joint 0) is a contiguous column of `size()` values,
+  /// so per-channel passes over the whole fleet touch only the memory they need and vectorize well.
+  /// Columns are padded to `COLUMN_ALIGNMENT` entries; the padding is always zero.
+  class GloveStateTable {
+    public:
+      using View = InputPeripheral<float*, bool*>;
+      using ConstView = InputPeripheral<const float*, const bool*>;
+
+      inline static constexpr const size_t COLUMN_ALIGNMENT = 16;
+
+      inline static constexpr const size_t FINGER_COUNT = 5;
+      inline static constexpr const size_t JOINT_COUNT = 4;
+      inline static constexpr const size_t BUTTON_COUNT = 5;
+      inline static constexpr const size_t ANALOG_BUTTON_COUNT = 2;
+
+      explicit GloveStateTable(size_t size);
+
+      [[nodiscard]] auto size() const -> size_t { return this->size_; }
+
+      /// Distance between the starts of two consecutive columns, in elements.
+      [[nodiscard]] auto stride() const -> size_t { return this->stride_; }
+
+      auto curl(size_t finger, size_t joint = 0) -> float* { return this->floatColumn(finger * JOINT_COUNT + joint); }
+      auto curl(size_t finger, size_t joint = 0) const -> const float* { return this->floatColumn(finger * JOINT_COUNT + joint); }
+
+      auto splay(size_t finger) -> float* { return this->floatColumn(SPLAY_COLUMN + finger); }
+      auto splay(size_t finger) const -> const float* { return this->floatColumn(SPLAY_COLUMN + finger); }
+
+      auto joystickX() -> float* { return this->floatColumn(JOYSTICK_COLUMN); }
+      auto joystickX() const -> const float* { return this->floatColumn(JOYSTICK_COLUMN); }
+      auto joystickY() -> float* { return this->floatColumn(JOYSTICK_COLUMN + 1); }
+      auto joystickY() const -> const float* { return this->floatColumn(JOYSTICK_COLUMN + 1); }
+      auto joystickPress() -> bool* { return this->boolColumn(JOYSTICK_PRESS_COLUMN); }
+      auto joystickPress() const -> const bool* { return this->boolColumn(JOYSTICK_PRESS_COLUMN); }
+
+      auto button(size_t index) -> bool* { return this->boolColumn(BUTTON_COLUMN + index); }
+      auto button(size_t index) const -> const bool* { return this->boolColumn(BUTTON_COLUMN + index); }
+
+      auto analogButtonPress(size_t index) -> bool* { return this->boolColumn(ANALOG_BUTTON_PRESS_COLUMN + index); }
+      auto analogButtonPress(size_t index) const -> const bool* { return this->boolColumn(ANALOG_BUTTON_PRESS_COLUMN + index); }
+      auto analogButtonValue(size_t index) -> float* { return this->floatColumn(ANALOG_BUTTON_VALUE_COLUMN + index); }
+      auto analogButtonValue(size_t index) const -> const float* { return this->floatColumn(ANALOG_BUTTON_VALUE_COLUMN + index); }
+
+      /// Pointers to every channel of a single glove, suitable for `AlphaEncoding::decodeInputPeripheral`.
+      auto view(size_t glove) -> View;
+      auto view(size_t glove) const -> ConstView;
+
+      /// Reconstruct the `InputPeripheralData` of a single glove.
+      [[nodiscard]] auto get(size_t glove) const -> InputPeripheralData;
+      auto set(size_t glove, const InputPeripheralData& input) -> void;
+
+      /// Decode a peripheral frame straight into the columns of `glove`.
+      template<typename Encoding = AlphaEncoding>
+      auto decode(size_t glove, const uint8_t* buffer, size_t buffer_size) -> bool;
+
+    private:
+      inline static constexpr const size_t SPLAY_COLUMN = FINGER_COUNT * JOINT_COUNT;
+      inline static constexpr const size_t JOYSTICK_COLUMN = SPLAY_COLUMN + FINGER_COUNT;
+      inline static constexpr const size_t ANALOG_BUTTON_VALUE_COLUMN = JOYSTICK_COLUMN + 2;
+      inline static constexpr const size_t FLOAT_COLUMN_COUNT = ANALOG_BUTTON_VALUE_COLUMN + ANALOG_BUTTON_COUNT;
+
+      inline static constexpr const size_t JOYSTICK_PRESS_COLUMN = 0;
+      inline static constexpr const size_t BUTTON_COLUMN = JOYSTICK_PRESS_COLUMN + 1;
+      inline static constexpr const size_t ANALOG_BUTTON_PRESS_COLUMN = BUTTON_COLUMN + BUTTON_COUNT;
+      inline static constexpr const size_t BOOL_COLUMN_COUNT = ANALOG_BUTTON_PRESS_COLUMN + ANALOG_BUTTON_COUNT;
+
+      size_t size_;
+      size_t stride_;
+      std::vector<float> floats_;
+      std::unique_ptr<bool[]> bools_; // NOLINT(*-avoid-c-arrays): std::vector<bool> can not hand out pointers
+
+      auto floatColumn(size_t column) -> float* { return this->floats_.data() + column * this->stride_; }
+      auto floatColumn(size_t column) const -> const float* { return this->floats_.data() + column * this->stride_; }
+      auto boolColumn(size_t column) -> bool* { return this->bools_.get() + column * this->stride_; }
+      auto boolColumn(size_t column) const -> const bool* { return this->bools_.get() + column * this->stride_; }
+
+      /// Call `fn(column_pointer, value)` for every channel of `view` and the matching field of `data`.
+      template<typename TView, typename TData, typename Fn>
+      static auto zip(TView& view, TData& data, Fn&& fn) -> void;
+
+      template<typename TView, typename TTable>
+      static auto makeView(TTable& table, size_t glove) -> TView;
+  };
+
+  inline GloveStateTable::GloveStateTable(size_t size) :
+    size_(size),
+    stride_((size + COLUMN_ALIGNMENT - 1) / COLUMN_ALIGNMENT * COLUMN_ALIGNMENT),
+    floats_(FLOAT_COLUMN_COUNT * stride_, 0.0F),
+    bools_(new bool[BOOL_COLUMN_COUNT * stride_]()) // NOLINT(*-avoid-c-arrays)
+  {
+  }
+
+  template<typename TView, typename TTable>
+  inline auto GloveStateTable::makeView(TTable &table, size_t glove) -> TView {
+    TView view;
+
+    for (size_t finger = 0; finger < FINGER_COUNT; finger++) {
+      for (size_t joint = 0; joint < JOINT_COUNT; joint++) {
+        view.curl.fingers[finger].curl[joint] = table.curl(finger, joint) + glove;
+      }
+      view.splay.fingers[finger] = table.splay(finger) + glove;
+    }
+
+    view.joystick.x = table.joystickX() + glove;
+    view.joystick.y = table.joystickY() + glove;
+    view.joystick.press = table.joystickPress() + glove;
+
+    for (size_t i = 0; i < BUTTON_COUNT; i++) {
+      view.buttons[i].press = table.button(i) + glove;
+    }
+
+    for (size_t i = 0; i < ANALOG_BUTTON_COUNT; i++) {
+      view.analog_buttons[i].press = table.analogButtonPress(i) + glove;
+      view.analog_buttons[i].value = table.analogButtonValue(i) + glove;
+    }
+
+    return view;
+  }
+
+  inline auto GloveStateTable::view(size_t glove) -> View {
+    return GloveStateTable::makeView<View>(*this, glove);
+  }
+
+  inline auto GloveStateTable::view(size_t glove) const -> ConstView {
+    return GloveStateTable::makeView<ConstView>(*this, glove);
+  }
+
+  template<typename TView, typename TData, typename Fn>
+  inline auto GloveStateTable::zip(TView &view, TData &data, Fn &&fn) -> void {
+    for (size_t finger = 0; finger < FINGER_COUNT; finger++) {
+      for (size_t joint = 0; joint < JOINT_COUNT; joint++) {
+        fn(view.curl.fingers[finger].curl[joint], data.curl.fingers[finger].curl[joint]);
+      }
+      fn(view.splay.fingers[finger], data.splay.fingers[finger]);
+    }
+
+    fn(view.joystick.x, data.joystick.x);
+    fn(view.joystick.y, data.joystick.y);
+    fn(view.joystick.press, data.joystick.press);
+
+    for (size_t i = 0; i < BUTTON_COUNT; i++) {
+      fn(view.buttons[i].press, data.buttons[i].press);
+    }
+
+    for (size_t i = 0; i < ANALOG_BUTTON_COUNT; i++) {
+      fn(view.analog_buttons[i].press, data.analog_buttons[i].press);
+      fn(view.analog_buttons[i].value, data.analog_buttons[i].value);
+    }
+  }
+
+  inline auto GloveStateTable::get(size_t glove) const -> InputPeripheralData {
+    InputPeripheralData data;
+    auto row = this->view(glove);
+
+    GloveStateTable::zip(row, data, [](const auto* column, auto& value) { value = *column; });
+
+    return data;
+  }
+
+  inline auto GloveStateTable::set(size_t glove, const InputPeripheralData &input) -> void {
+    auto row = this->view(glove);
+
+    GloveStateTable::zip(row, input, [](auto* column, const auto& value) { *column = value; });
+  }
+
+  template<typename Encoding>
+  inline auto GloveStateTable::decode(size_t glove, const uint8_t *buffer, size_t buffer_size) -> bool {
+    auto row = this->view(glove);
+
+    return Encoding::decodeInputPeripheral(buffer, buffer_size, row);
+  }
+} // namespace opengloves
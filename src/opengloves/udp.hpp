@@ -0,0 +1,303 @@
+#pragma once
+
+#include <opengloves.hpp>
+#include <opengloves/state_table.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__) && __has_include(<sys/socket.h>) && __has_include(<netinet/in.h>)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#define OPENGLOVES_HAS_UDP
+#endif
+
+#ifdef OPENGLOVES_HAS_UDP
+
+namespace opengloves {
+  /// Every datagram carries one encoded frame, after the glove id as a big-endian 16-bit header.
+  inline constexpr const size_t UDP_HEADER_SIZE = 2;
+
+  /// IPv4 UDP socket, closed on destruction.
+  class UdpSocket {
+    public:
+      UdpSocket() = default;
+      ~UdpSocket() { this->close(); }
+
+      UdpSocket(const UdpSocket&) = delete;
+      auto operator=(const UdpSocket&) -> UdpSocket& = delete;
+
+      /// Receive on `address`, e.g. `0.0.0.0`; port `0` picks a free one, see `port()`.
+      /// \return `false` if the address is invalid or the socket could not be bound.
+      auto bind(const char* address, std::uint16_t port) -> bool;
+
+      /// Send to `address` by default.
+      /// \return `false` if the address is invalid or the socket could not be created.
+      auto connect(const char* address, std::uint16_t port) -> bool;
+
+      auto close() -> void;
+
+      [[nodiscard]] auto isOpen() const -> bool { return this->fd_ >= 0; }
+      [[nodiscard]] auto fd() const -> int { return this->fd_; }
+
+      /// Local port, `0` if the socket is not open.
+      [[nodiscard]] auto port() const -> std::uint16_t;
+
+    private:
+      int fd_ = -1;
+
+      /// Create the socket, and resolve `address` into `target`.
+      auto open(const char* address, std::uint16_t port, sockaddr_in& target) -> bool;
+  };
+
+  inline auto UdpSocket::open(const char* address, std::uint16_t port, sockaddr_in& target) -> bool {
+    this->close();
+
+    target = {};
+    target.sin_family = AF_INET;
+    target.sin_port = htons(port);
+    if (inet_pton(AF_INET, address, &target.sin_addr) != 1) {
+      return false;
+    }
+
+    this->fd_ = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0); // NOLINT(*-signed-bitwise)
+    return this->fd_ >= 0;
+  }
+
+  inline auto UdpSocket::bind(const char* address, std::uint16_t port) -> bool {
+    sockaddr_in target{};
+    if (!this->open(address, port, target)) {
+      return false;
+    }
+
+    if (::bind(this->fd_, reinterpret_cast<const sockaddr*>(&target), sizeof(target)) != 0) {
+      this->close();
+      return false;
+    }
+    return true;
+  }
+
+  inline auto UdpSocket::connect(const char* address, std::uint16_t port) -> bool {
+    sockaddr_in target{};
+    if (!this->open(address, port, target)) {
+      return false;
+    }
+
+    if (::connect(this->fd_, reinterpret_cast<const sockaddr*>(&target), sizeof(target)) != 0) {
+      this->close();
+      return false;
+    }
+    return true;
+  }
+
+  inline auto UdpSocket::close() -> void {
+    if (this->fd_ >= 0) {
+      ::close(this->fd_);
+    }
+    this->fd_ = -1;
+  }
+
+  inline auto UdpSocket::port() const -> std::uint16_t {
+    sockaddr_in local{};
+    socklen_t size = sizeof(local);
+    if (this->fd_ < 0 || getsockname(this->fd_, reinterpret_cast<sockaddr*>(&local), &size) != 0) {
+      return 0;
+    }
+    return ntohs(local.sin_port);
+  }
+
+  /// Relays frames of many gloves to one host, `BatchSize` datagrams per `sendmmsg` call.
+  ///
+  /// Frames are encoded straight into the batch, which is sent once it is full or on `flush()`.
+  template<size_t BatchSize = 32, size_t DatagramSize = 256>
+  class UdpBatchSender {
+    public:
+      UdpBatchSender() {
+        for (size_t i = 0; i < BatchSize; i++) {
+          this->iovecs_[i] = { this->datagrams_[i].data(), 0 };
+          this->messages_[i] = {};
+          this->messages_[i].msg_hdr.msg_iov = &this->iovecs_[i];
+          this->messages_[i].msg_hdr.msg_iovlen = 1;
+        }
+      }
+
+      UdpBatchSender(const UdpBatchSender&) = delete;
+      auto operator=(const UdpBatchSender&) -> UdpBatchSender& = delete;
+
+      /// \return `false` if the address is invalid or the socket could not be created.
+      auto open(const char* address, std::uint16_t port) -> bool {
+        this->pending_ = 0;
+        return this->socket_.connect(address, port);
+      }
+
+      auto close() -> void { this->socket_.close(); }
+
+      [[nodiscard]] auto isOpen() const -> bool { return this->socket_.isOpen(); }
+      [[nodiscard]] auto socket() const -> const UdpSocket& { return this->socket_; }
+
+      /// Datagrams waiting for the next `flush()`.
+      [[nodiscard]] auto pending() const -> size_t { return this->pending_; }
+
+      /// Queue a frame of `glove` by encoding it into the batch with `encode(buffer, buffer_size) -> written`,
+      /// e.g. a lambda calling `AlphaEncoding::encodeInputPeripheral`.
+      /// \return `false` if nothing was written, or the frame did not fit.
+      template<typename Encode>
+      auto emplace(std::uint16_t glove, Encode&& encode) -> bool;
+
+      /// Queue an already encoded frame of `glove`.
+      auto push(std::uint16_t glove, const uint8_t* frame, size_t frame_size) -> bool {
+        if (frame_size > DatagramSize - UDP_HEADER_SIZE) {
+          return false;
+        }
+
+        return this->emplace(glove, [frame, frame_size](uint8_t* buffer, int /*buffer_size*/) {
+          std::memcpy(buffer, frame, frame_size);
+          return static_cast<int>(frame_size);
+        });
+      }
+
+      /// Send every pending datagram.
+      /// \return The number of datagrams sent; the rest of the batch is dropped on error, like lost datagrams.
+      auto flush() -> size_t;
+
+    private:
+      UdpSocket socket_;
+
+      std::array<std::array<uint8_t, DatagramSize>, BatchSize> datagrams_{};
+      std::array<iovec, BatchSize> iovecs_{};
+      std::array<mmsghdr, BatchSize> messages_{};
+      size_t pending_ = 0;
+  };
+
+  template<size_t BatchSize, size_t DatagramSize>
+  template<typename Encode>
+  inline auto UdpBatchSender<BatchSize, DatagramSize>::emplace(std::uint16_t glove, Encode&& encode) -> bool {
+    if (this->pending_ == BatchSize) {
+      this->flush();
+    }
+
+    auto& datagram = this->datagrams_[this->pending_];
+    datagram[0] = static_cast<uint8_t>(glove >> 8U);
+    datagram[1] = static_cast<uint8_t>(glove & 0xFFU);
+
+    const auto written = encode(datagram.data() + UDP_HEADER_SIZE, static_cast<int>(DatagramSize - UDP_HEADER_SIZE));
+    if (written <= 0 || static_cast<size_t>(written) > DatagramSize - UDP_HEADER_SIZE) {
+      return false;
+    }
+
+    this->iovecs_[this->pending_].iov_len = UDP_HEADER_SIZE + static_cast<size_t>(written);
+    this->pending_++;
+    return true;
+  }
+
+  template<size_t BatchSize, size_t DatagramSize>
+  inline auto UdpBatchSender<BatchSize, DatagramSize>::flush() -> size_t {
+    size_t sent = 0;
+
+    // sendmmsg() may stop early, e.g. when interrupted; carry on from there
+    while (sent < this->pending_) {
+      const auto result = sendmmsg(this->socket_.fd(), this->messages_.data() + sent, static_cast<unsigned>(this->pending_ - sent), 0);
+      if (result <= 0) {
+        break;
+      }
+      sent += static_cast<size_t>(result);
+    }
+
+    this->pending_ = 0;
+    return sent;
+  }
+
+  /// Receives frames of many gloves, up to `BatchSize` datagrams per `recvmmsg` call, and hands them out per glove
+  /// without copying them out of the receive buffers.
+  template<size_t BatchSize = 32, size_t DatagramSize = 256>
+  class UdpBatchReceiver {
+    public:
+      UdpBatchReceiver() {
+        for (size_t i = 0; i < BatchSize; i++) {
+          this->iovecs_[i] = { this->datagrams_[i].data(), DatagramSize };
+          this->messages_[i] = {};
+          this->messages_[i].msg_hdr.msg_iov = &this->iovecs_[i];
+          this->messages_[i].msg_hdr.msg_iovlen = 1;
+        }
+      }
+
+      UdpBatchReceiver(const UdpBatchReceiver&) = delete;
+      auto operator=(const UdpBatchReceiver&) -> UdpBatchReceiver& = delete;
+
+      /// See `UdpSocket::bind`.
+      auto bind(const char* address, std::uint16_t port) -> bool { return this->socket_.bind(address, port); }
+
+      auto close() -> void { this->socket_.close(); }
+
+      [[nodiscard]] auto isOpen() const -> bool { return this->socket_.isOpen(); }
+      [[nodiscard]] auto socket() const -> const UdpSocket& { return this->socket_; }
+
+      /// Call `fn(glove, frame, frame_size)` for every datagram of one batch. Frames point into the receive
+      /// buffers, and are only valid until the next receive. Datagrams without a header, or truncated, are skipped.
+      ///
+      /// Waits up to `timeout` microseconds for the first datagram, `0` does not wait.
+      /// \return The number of datagrams received, including skipped ones.
+      template<typename Fn>
+      auto receive(Fn&& fn, std::uint32_t timeout = 0) -> size_t;
+
+      /// Decode one batch of input frames into the rows of `table`, frames of gloves outside it are skipped.
+      /// \return The number of datagrams received.
+      template<typename Encoding = AlphaEncoding>
+      auto receive(GloveStateTable& table, std::uint32_t timeout = 0) -> size_t {
+        return this->receive(
+            [&table](std::uint16_t glove, const uint8_t* frame, size_t frame_size) {
+              if (glove < table.size()) {
+                table.decode<Encoding>(glove, frame, frame_size);
+              }
+            },
+            timeout
+        );
+      }
+
+    private:
+      UdpSocket socket_;
+
+      std::array<std::array<uint8_t, DatagramSize>, BatchSize> datagrams_{};
+      std::array<iovec, BatchSize> iovecs_{};
+      std::array<mmsghdr, BatchSize> messages_{};
+  };
+
+  template<size_t BatchSize, size_t DatagramSize>
+  template<typename Fn>
+  inline auto UdpBatchReceiver<BatchSize, DatagramSize>::receive(Fn&& fn, std::uint32_t timeout) -> size_t {
+    if (timeout != 0) {
+      pollfd descriptor{ this->socket_.fd(), POLLIN, 0 };
+      const timespec duration{ static_cast<time_t>(timeout / 1'000'000U), static_cast<long>(timeout % 1'000'000U) * 1'000L };
+      if (ppoll(&descriptor, 1, &duration, nullptr) <= 0) {
+        return 0;
+      }
+    }
+
+    const auto result = recvmmsg(this->socket_.fd(), this->messages_.data(), BatchSize, MSG_DONTWAIT, nullptr);
+    if (result <= 0) {
+      return 0;
+    }
+
+    const auto count = static_cast<size_t>(result);
+    for (size_t i = 0; i < count; i++) {
+      const auto& message = this->messages_[i];
+      if (message.msg_len < UDP_HEADER_SIZE || (message.msg_hdr.msg_flags & MSG_TRUNC) != 0) {
+        continue;
+      }
+
+      const auto* datagram = this->datagrams_[i].data();
+      const auto glove = static_cast<std::uint16_t>((datagram[0] << 8U) | datagram[1]);
+      fn(glove, datagram + UDP_HEADER_SIZE, message.msg_len - UDP_HEADER_SIZE);
+    }
+
+    return count;
+  }
+} // namespace opengloves
+
+#endif
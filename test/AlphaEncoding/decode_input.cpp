@@ -0,0 +1,141 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+
+using namespace opengloves;
+
+auto decode(const std::string &data) -> InputData {
+  return AlphaEncoding::decodeInput(reinterpret_cast<const uint8_t *>(data.c_str()), data.size());
+}
+
+void checkRoundTrip(const InputPeripheralData &input) {
+  std::string encoded(256, '\0');
+  auto written = AlphaEncoding::encodeInput(input, reinterpret_cast<uint8_t *>(encoded.data()), encoded.size());
+
+  auto actual = AlphaEncoding::decodeInput(reinterpret_cast<const uint8_t *>(encoded.data()), written);
+  REQUIRE(std::holds_alternative<InputPeripheralData>(actual));
+
+  const auto &decoded = std::get<InputPeripheralData>(actual);
+  for (size_t i = 0; i < input.curl.fingers.size(); i++) {
+    for (size_t j = 0; j < input.curl.fingers[i].curl.size(); j++) {
+      REQUIRE_THAT(decoded.curl.fingers[i].curl[j], Catch::Matchers::WithinAbs(input.curl.fingers[i].curl[j], 1.0 / 4095));
+    }
+    REQUIRE_THAT(decoded.splay.fingers[i], Catch::Matchers::WithinAbs(input.splay.fingers[i], 1.0 / 4095));
+  }
+  REQUIRE_THAT(decoded.joystick.x, Catch::Matchers::WithinAbs(input.joystick.x, 1.0 / 4095));
+  REQUIRE_THAT(decoded.joystick.y, Catch::Matchers::WithinAbs(input.joystick.y, 1.0 / 4095));
+  REQUIRE(decoded.joystick.press == input.joystick.press);
+  for (size_t i = 0; i < input.buttons.size(); i++) {
+    REQUIRE(decoded.buttons[i].press == input.buttons[i].press);
+  }
+  for (size_t i = 0; i < input.analog_buttons.size(); i++) {
+    REQUIRE(decoded.analog_buttons[i].press == input.analog_buttons[i].press);
+  }
+}
+
+TEST_CASE("AlphaEncoding::decodeInput", "[alpha]") {
+  REQUIRE(std::holds_alternative<InputInvalid>(decode("")));
+  REQUIRE(std::holds_alternative<InputInvalid>(decode("\n")));
+  REQUIRE(std::holds_alternative<InputInvalid>(decode("123")));
+  REQUIRE(std::holds_alternative<InputInvalid>(decode("(ZZ)1\n")));
+
+  SECTION("InputInfoData") {
+    auto actual = decode("(ZV)42(ZG)0(ZH)1\n");
+
+    REQUIRE(std::holds_alternative<InputInfoData>(actual));
+    const auto &info = std::get<InputInfoData>(actual);
+    REQUIRE(info.firmware_version == 42);
+    REQUIRE(info.device_type == DeviceType_LucidGloves);
+    REQUIRE(info.hand == Hand_Right);
+  }
+
+  SECTION("InputPeripheralData") {
+    auto actual = decode("A0B4095C0D0E0F4095H(BAB)4095(CB)4095JM\n");
+
+    REQUIRE(std::holds_alternative<InputPeripheralData>(actual));
+    const auto &input = std::get<InputPeripheralData>(actual);
+    REQUIRE(input.curl.index.curl_total == 1.0f);
+    REQUIRE(input.curl.index.curl_joint1 == 1.0f);
+    REQUIRE(input.curl.thumb.curl_total == 0.0f);
+    REQUIRE(input.splay.middle == 1.0f);
+    REQUIRE(input.joystick.x == 1.0f);
+    REQUIRE(input.joystick.y == 0.0f);
+    REQUIRE(input.joystick.press);
+    REQUIRE(input.button_a.press);
+    REQUIRE(input.pinch.press);
+    REQUIRE_FALSE(input.button_b.press);
+    REQUIRE_FALSE(input.trigger.press);
+  }
+
+  SECTION("Only first frame is decoded") {
+    auto actual = decode("A4095\nB4095\n");
+
+    REQUIRE(std::holds_alternative<InputPeripheralData>(actual));
+    REQUIRE(std::get<InputPeripheralData>(actual).curl.thumb.curl_total == 1.0f);
+    REQUIRE(std::get<InputPeripheralData>(actual).curl.index.curl_total == 0.0f);
+  }
+
+  SECTION("Round trip") {
+    InputPeripheralData input;
+    checkRoundTrip(input);
+
+    input.curl = {
+        .thumb = { .curl = { 0.25f, 0.5f, 0.75f, 1.0f } },
+        .index = { .curl = { 0.25f, 0.5f, 0.75f, 1.0f } },
+        .middle = { .curl = { 0.25f, 0.5f, 0.75f, 1.0f } },
+        .ring = { .curl = { 0.25f, 0.5f, 0.75f, 1.0f } },
+        .pinky = { .curl = { 0.25f, 0.5f, 0.75f, 1.0f } },
+    };
+    input.splay = {
+        .thumb = 0.5,
+        .index = 0.5,
+        .middle = 0.5,
+        .ring = 0.5,
+        .pinky = 0.5,
+    };
+    input.button_a.press = true;
+    input.button_menu.press = true;
+    input.trigger.press = true;
+    input.joystick = {
+        .x = 0.5,
+        .y = 0.25,
+        .press = true,
+    };
+    checkRoundTrip(input);
+  }
+
+  SECTION("Pointer layout") {
+    std::array<float, 4> thumb{ 1.0f, 1.0f, 1.0f, 1.0f };
+    float splay = 1.0f;
+    bool button = true;
+    float dummy_float = 0.0f;
+    bool dummy_bool = false;
+
+    InputPeripheral<float *, bool *> view;
+    for (auto &finger : view.curl.fingers) {
+      finger.curl = { &dummy_float, &dummy_float, &dummy_float, &dummy_float };
+    }
+    for (auto &finger : view.splay.fingers) {
+      finger = &dummy_float;
+    }
+    view.curl.thumb.curl = { &thumb[0], &thumb[1], &thumb[2], &thumb[3] };
+    view.splay.thumb = &splay;
+    view.joystick = { &dummy_float, &dummy_float, &dummy_bool };
+    for (auto &btn : view.buttons) {
+      btn.press = &dummy_bool;
+    }
+    view.button_b.press = &button;
+    for (auto &btn : view.analog_buttons) {
+      btn.press = &dummy_bool;
+      btn.value = &dummy_float;
+    }
+
+    const std::string data = "A4095(AAC)4095\n";
+    REQUIRE(AlphaEncoding::decodeInputPeripheral(reinterpret_cast<const uint8_t *>(data.c_str()), data.size(), view));
+
+    REQUIRE(thumb == std::array<float, 4>{ 1.0f, 0.0f, 1.0f, 0.0f });
+    REQUIRE(splay == 0.0f);
+    REQUIRE_FALSE(button);
+  }
+}
@@ -0,0 +1,65 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+
+using namespace opengloves;
+
+TEST_CASE("AlphaEncoding metadata", "[alpha]") {
+  FrameMetadata metadata{};
+  metadata.sequence = 7;
+  metadata.timestamp = 4'294'967'295U;
+  metadata.echo_timestamp = 1000;
+
+  std::string encoded(256, '\0');
+
+  SECTION("encodeMetadata") {
+    AlphaEncoding::encodeMetadata(FrameMetadata{}, reinterpret_cast<uint8_t *>(encoded.data()), encoded.size());
+    REQUIRE(encoded.c_str() == std::string(""));
+
+    AlphaEncoding::encodeMetadata(metadata, reinterpret_cast<uint8_t *>(encoded.data()), encoded.size());
+    REQUIRE(encoded.c_str() == std::string("(ZQ)7(ZT)4294967295(ZR)1000"));
+
+    // Keys are never truncated
+    auto written = AlphaEncoding::encodeMetadata(metadata, reinterpret_cast<uint8_t *>(encoded.data()), 12);
+    REQUIRE(written == 5);
+  }
+
+  SECTION("Input") {
+    auto written = AlphaEncoding::encodeInput(InputPeripheralData(), metadata, reinterpret_cast<uint8_t *>(encoded.data()), encoded.size());
+    REQUIRE(encoded.substr(0, written) == "(ZQ)7(ZT)4294967295(ZR)1000A0B0C0D0E0\n");
+
+    REQUIRE(AlphaEncoding::decodeMetadata(reinterpret_cast<const uint8_t *>(encoded.data()), written) == metadata);
+
+    // Peripheral data is unaffected by the metadata
+    auto decoded = AlphaEncoding::decodeInput(reinterpret_cast<const uint8_t *>(encoded.data()), written);
+    REQUIRE(std::holds_alternative<InputPeripheralData>(decoded));
+
+    REQUIRE(AlphaEncoding::encodeInput(InputInvalid(), metadata, reinterpret_cast<uint8_t *>(encoded.data()), encoded.size()) == 0);
+  }
+
+  SECTION("Output") {
+    FrameMetadata sequence_only{};
+    sequence_only.sequence = 42;
+
+    OutputForceFeedbackData ffb{ .thumb = 1.0f, .index = 0.0f, .middle = 0.0f, .ring = 0.0f, .pinky = 0.0f };
+    auto written = AlphaEncoding::encodeOutput(ffb, sequence_only, reinterpret_cast<uint8_t *>(encoded.data()), encoded.size());
+    REQUIRE(encoded.substr(0, written) == "(ZQ)42A4095B0C0D0E0\n");
+
+    REQUIRE(AlphaEncoding::decodeMetadata(reinterpret_cast<const uint8_t *>(encoded.data()), written) == sequence_only);
+
+    // Old decoders ignore the unknown keys
+    auto decoded = AlphaEncoding::decodeOutput(reinterpret_cast<const uint8_t *>(encoded.data()), written);
+    REQUIRE(std::holds_alternative<OutputForceFeedbackData>(decoded));
+    REQUIRE(std::get<OutputForceFeedbackData>(decoded) == ffb);
+
+    written = AlphaEncoding::encodeOutput(OutputHapticsData{ 0.5f, 0.5f, 0.5f }, metadata, reinterpret_cast<uint8_t *>(encoded.data()), encoded.size());
+    decoded = AlphaEncoding::decodeOutput(reinterpret_cast<const uint8_t *>(encoded.data()), written);
+    REQUIRE(std::holds_alternative<OutputHapticsData>(decoded));
+  }
+
+  SECTION("decodeMetadata without metadata") {
+    const std::string data = "A0B0C0D0E0\n";
+    REQUIRE(AlphaEncoding::decodeMetadata(reinterpret_cast<const uint8_t *>(data.data()), data.size()) == FrameMetadata{});
+  }
+}
@@ -0,0 +1,64 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+
+using namespace opengloves;
+
+TEMPLATE_TEST_CASE("AlphaEncoding resolution round trip", "[alpha]", AlphaEncoding8, AlphaEncoding10, AlphaEncoding12, AlphaEncoding16) {
+  const auto max_value = TestType::maxAnalogValue(0);
+  const auto step = 1.0F / max_value;
+
+  std::string encoded(256, '\0');
+
+  SECTION("Input") {
+    InputPeripheralData input;
+    input.curl.thumb.curl_total = 1.0F;
+    input.curl.index.curl_total = 0.5F;
+    input.curl.middle.curl[2] = 0.25F;
+    input.splay.ring = 0.75F;
+    input.joystick.y = 0.1F;
+
+    auto written = TestType::encodeInputPeripheral(input, reinterpret_cast<uint8_t *>(encoded.data()), encoded.size());
+    REQUIRE(encoded.substr(0, 1 + std::to_string(static_cast<int>(max_value)).size()) == "A" + std::to_string(static_cast<int>(max_value)));
+
+    InputPeripheralData decoded;
+    REQUIRE(TestType::decodeInputPeripheral(reinterpret_cast<const uint8_t *>(encoded.data()), written, decoded));
+    REQUIRE(decoded.curl.thumb.curl_total == 1.0F);
+    REQUIRE_THAT(decoded.curl.index.curl_total, Catch::Matchers::WithinAbs(0.5F, step));
+    REQUIRE_THAT(decoded.curl.middle.curl[2], Catch::Matchers::WithinAbs(0.25F, step));
+    REQUIRE_THAT(decoded.splay.ring, Catch::Matchers::WithinAbs(0.75F, step));
+    REQUIRE_THAT(decoded.joystick.y, Catch::Matchers::WithinAbs(0.1F, step));
+  }
+
+  SECTION("Force feedback") {
+    OutputForceFeedbackData ffb{ .thumb = 1.0F, .index = 0.5F, .middle = 0.25F, .ring = 0.0F, .pinky = 0.75F };
+
+    auto written = TestType::encodeOutput(ffb, reinterpret_cast<uint8_t *>(encoded.data()), encoded.size());
+    auto decoded = TestType::decodeOutput(reinterpret_cast<const uint8_t *>(encoded.data()), written);
+    REQUIRE(std::holds_alternative<OutputForceFeedbackData>(decoded));
+
+    const auto& decoded_ffb = std::get<OutputForceFeedbackData>(decoded);
+    REQUIRE(decoded_ffb.thumb == 1.0F);
+    REQUIRE_THAT(decoded_ffb.index, Catch::Matchers::WithinAbs(0.5F, step));
+    REQUIRE_THAT(decoded_ffb.middle, Catch::Matchers::WithinAbs(0.25F, step));
+    REQUIRE(decoded_ffb.ring == 0.0F);
+    REQUIRE_THAT(decoded_ffb.pinky, Catch::Matchers::WithinAbs(0.75F, step));
+  }
+}
+
+TEST_CASE("AlphaEncoding resolution sizes", "[alpha]") {
+  OutputForceFeedbackData ffb{ .thumb = 1.0F, .index = 1.0F, .middle = 1.0F, .ring = 1.0F, .pinky = 1.0F };
+  std::string encoded(256, '\0');
+
+  REQUIRE(AlphaEncoding8::encodeOutput(ffb, reinterpret_cast<uint8_t *>(encoded.data()), encoded.size()) == 21);
+  REQUIRE(encoded.c_str() == std::string("A255B255C255D255E255\n"));
+
+  REQUIRE(AlphaEncoding12::encodeOutput(ffb, reinterpret_cast<uint8_t *>(encoded.data()), encoded.size()) == 26);
+  REQUIRE(AlphaEncoding16::encodeOutput(ffb, reinterpret_cast<uint8_t *>(encoded.data()), encoded.size()) == 31);
+  REQUIRE(encoded.c_str() == std::string("A65535B65535C65535D65535E65535\n"));
+
+  // Frames of a different range decode, just scaled wrong: both ends need the same encoding
+  auto decoded = AlphaEncoding::decodeOutput(reinterpret_cast<const uint8_t *>(encoded.data()), 31);
+  REQUIRE(std::get<OutputForceFeedbackData>(decoded).thumb > 1.0F);
+}
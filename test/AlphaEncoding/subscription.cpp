@@ -0,0 +1,80 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+
+using namespace opengloves;
+
+TEST_CASE("AlphaEncoding negotiation", "[alpha]") {
+  std::string encoded(256, '\0');
+
+  SECTION("Info advertises channels and rate") {
+    InputInfoData info{ .hand = Hand_Right, .device_type = DeviceType_LucidGloves, .firmware_version = 42 };
+    info.channels = InputChannel_Curl | InputChannel_Buttons;
+    info.max_rate = 500;
+
+    auto written = AlphaEncoding::encodeInputInfo(info, reinterpret_cast<uint8_t *>(encoded.data()), encoded.size());
+    REQUIRE(encoded.substr(0, written) == "(ZV)42(ZG)0(ZH)1(ZC)17(ZF)500\n");
+
+    auto decoded = AlphaEncoding::decodeInput(reinterpret_cast<const uint8_t *>(encoded.data()), written);
+    REQUIRE(std::holds_alternative<InputInfoData>(decoded));
+
+    const auto& decoded_info = std::get<InputInfoData>(decoded);
+    REQUIRE(decoded_info.firmware_version == 42);
+    REQUIRE(decoded_info.hand == Hand_Right);
+    REQUIRE(decoded_info.channels == info.channels);
+    REQUIRE(decoded_info.max_rate == 500);
+  }
+
+  SECTION("Subscription round trip") {
+    OutputSubscriptionData subscription{ .channels = InputChannel_Curl | InputChannel_Joystick, .rate = 90, .resolution = 8 };
+
+    auto written = AlphaEncoding::encodeOutput(subscription, reinterpret_cast<uint8_t *>(encoded.data()), encoded.size());
+    REQUIRE(encoded.substr(0, written) == "(ZC)9(ZF)90(ZP)8\n");
+
+    auto decoded = AlphaEncoding::decodeOutput(reinterpret_cast<const uint8_t *>(encoded.data()), written);
+    REQUIRE(std::holds_alternative<OutputSubscriptionData>(decoded));
+    REQUIRE(std::get<OutputSubscriptionData>(decoded) == subscription);
+  }
+
+  SECTION("Peripheral honours the subscription") {
+    InputPeripheralData input;
+    input.curl.index.curl_total = 1.0F;
+    input.curl.index.curl[1] = 0.5F;
+    input.splay.index = 0.5F;
+    input.joystick.x = 1.0F;
+    input.joystick.press = true;
+    input.button_a.press = true;
+    input.trigger.press = true;
+
+    OutputSubscriptionData subscription{ .channels = InputChannel_Curl | InputChannel_Joystick, .rate = 0, .resolution = 8 };
+
+    auto written = AlphaEncoding::encodeInputPeripheral(input, subscription, reinterpret_cast<uint8_t *>(encoded.data()), encoded.size());
+    REQUIRE(encoded.substr(0, written) == "A0B255C0D0E0F255H\n");
+
+    InputPeripheralData decoded;
+    REQUIRE(AlphaEncoding::decodeInputPeripheral(reinterpret_cast<const uint8_t *>(encoded.data()), written, decoded, 8));
+    REQUIRE(decoded.curl.index.curl_total == 1.0F);
+    REQUIRE(decoded.curl.index.curl[1] == 0.0F);
+    REQUIRE(decoded.splay.index == 0.0F);
+    REQUIRE(decoded.joystick.x == 1.0F);
+    REQUIRE(decoded.joystick.press);
+    REQUIRE_FALSE(decoded.button_a.press);
+    REQUIRE_FALSE(decoded.trigger.press);
+
+    // Everything at the default resolution is the plain encoder
+    std::string plain(256, '\0');
+    subscription = { .channels = InputChannel_All, .rate = 0, .resolution = 0 };
+    written = AlphaEncoding::encodeInputPeripheral(input, subscription, reinterpret_cast<uint8_t *>(encoded.data()), encoded.size());
+    auto plain_written = AlphaEncoding::encodeInputPeripheral(input, reinterpret_cast<uint8_t *>(plain.data()), plain.size());
+    REQUIRE(encoded.substr(0, written) == plain.substr(0, plain_written));
+  }
+
+  SECTION("Resolution") {
+    REQUIRE(AlphaEncoding::maxAnalogValue(0) == 4095.0F);
+    REQUIRE(AlphaEncoding::maxAnalogValue(8) == 255.0F);
+    REQUIRE(AlphaEncoding::maxAnalogValue(10) == 1023.0F);
+    REQUIRE(AlphaEncoding::maxAnalogValue(16) == 65535.0F);
+    REQUIRE(AlphaEncoding::maxAnalogValue(32) == 65535.0F);
+  }
+}
@@ -0,0 +1,164 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+#include <opengloves/bulk_decoder.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+using namespace opengloves;
+
+namespace {
+  auto makeLog(size_t frames) -> std::string {
+    std::string log;
+    std::string buffer(64, '\0');
+
+    for (size_t i = 0; i < frames; i++) {
+      int written = 0;
+      if (i % 3 == 2) {
+        written = AlphaEncoding::encodeOutput(OutputHapticsData{ 0.5f, static_cast<float>(i % 100) / 100.0f, 1.0f }, reinterpret_cast<uint8_t*>(buffer.data()), buffer.size());
+      } else {
+        const auto value = static_cast<float>(i % 4096) / 4095.0f;
+        written = AlphaEncoding::encodeOutput(OutputForceFeedbackData{ .thumb = value, .index = 1.0f - value, .middle = 0.0f, .ring = 0.5f, .pinky = value }, reinterpret_cast<uint8_t*>(buffer.data()), buffer.size());
+      }
+      log.append(buffer.data(), written);
+    }
+
+    return log;
+  }
+} // namespace
+
+TEST_CASE("WorkStealingPool", "[bulk_decoder]") {
+  const auto threads = GENERATE(1, 2, 4);
+  WorkStealingPool pool(threads);
+
+  REQUIRE(pool.size() == static_cast<size_t>(threads));
+
+  // Run several batches on the same pool, every task exactly once
+  for (const size_t tasks : { 0, 1, 3, 1000 }) {
+    std::vector<std::atomic<int>> runs(tasks);
+    pool.run(tasks, [&runs](size_t task) { runs[task]++; });
+
+    for (const auto& count : runs) {
+      REQUIRE(count == 1);
+    }
+  }
+
+#ifdef __cpp_exceptions
+  // Exceptions reach the caller once the batch is done, and the pool stays usable
+  std::vector<std::atomic<int>> runs(100);
+  REQUIRE_THROWS_AS(
+      pool.run(runs.size(), [&runs](size_t task) {
+        runs[task]++;
+        if (task % 10 == 3) {
+          throw std::runtime_error("task");
+        }
+      }),
+      std::runtime_error
+  );
+  for (const auto& count : runs) {
+    REQUIRE(count == 1);
+  }
+  pool.run(runs.size(), [&runs](size_t task) { runs[task]++; });
+  REQUIRE(runs[99] == 2);
+#endif
+}
+
+TEST_CASE("BulkDecoder", "[bulk_decoder]") {
+  const auto threads = GENERATE(1, 3);
+  const auto chunk_size = GENERATE(1, 7, 64, 100'000);
+  BulkDecoder decoder(threads, chunk_size);
+
+  REQUIRE(decoder.threadCount() == static_cast<size_t>(threads));
+
+  SECTION("Matches sequential decoding") {
+    const auto log = makeLog(1000);
+    const auto* data = reinterpret_cast<const uint8_t*>(log.data());
+
+    REQUIRE(decoder.countFrames(data, log.size()) == 1000);
+
+    std::vector<OutputData> output(1000);
+    REQUIRE(decoder.decodeOutput(data, log.size(), output.data(), output.size()) == 1000);
+
+    size_t offset = 0;
+    for (const auto& actual : output) {
+      const auto end = log.find('\n', offset) + 1;
+      REQUIRE(actual == AlphaEncoding::decodeOutput(data + offset, end - offset));
+      offset = end;
+    }
+  }
+
+  SECTION("Partial lines and small outputs") {
+    const std::string log = "A4095\n\nF1.00G1.00H1.00";
+    const auto* data = reinterpret_cast<const uint8_t*>(log.data());
+
+    REQUIRE(decoder.countFrames(data, log.size()) == 3);
+    REQUIRE(decoder.countFrames(data, 0) == 0);
+
+    std::vector<OutputData> output(2);
+    REQUIRE(decoder.decodeOutput(data, log.size(), output.data(), output.size()) == 3);
+    REQUIRE(std::holds_alternative<OutputForceFeedbackData>(output[0]));
+    REQUIRE(std::holds_alternative<OutputInvalid>(output[1]));
+  }
+
+  SECTION("Other resolutions") {
+    const std::string log = "A255B0C0D0E0\nA1023B0C0D0E0\n";
+    std::vector<OutputData> output(2);
+
+    REQUIRE(decoder.decodeOutput<AlphaEncoding10>(reinterpret_cast<const uint8_t*>(log.data()), log.size(), output.data(), output.size()) == 2);
+    REQUIRE_THAT(std::get<OutputForceFeedbackData>(output[0]).thumb, Catch::Matchers::WithinAbs(255.0f / 1023.0f, 0.0001f));
+    REQUIRE(std::get<OutputForceFeedbackData>(output[1]).thumb == 1.0f);
+  }
+
+#ifdef __cpp_exceptions
+  SECTION("Malformed lines") {
+    const std::string log = "A4095\nA.\nB9999999999999999999999999999999999999999\nF.G1H1\nA0\n";
+    std::vector<OutputData> output(5);
+
+    REQUIRE(decoder.decodeOutput(reinterpret_cast<const uint8_t*>(log.data()), log.size(), output.data(), output.size()) == 5);
+    REQUIRE(std::holds_alternative<OutputForceFeedbackData>(output[0]));
+    REQUIRE(std::holds_alternative<OutputInvalid>(output[1]));
+    REQUIRE(std::holds_alternative<OutputInvalid>(output[2]));
+    REQUIRE(std::holds_alternative<OutputInvalid>(output[3]));
+    REQUIRE(std::holds_alternative<OutputForceFeedbackData>(output[4]));
+  }
+#endif
+
+  SECTION("Custom decoder") {
+    const std::string log = "A0\nA1\nA2\n";
+    std::vector<size_t> lengths(3);
+
+    decoder.decode(reinterpret_cast<const uint8_t*>(log.data()), log.size(), lengths.data(), lengths.size(), [](const uint8_t* /*frame*/, size_t size) { return size; });
+    REQUIRE(lengths == std::vector<size_t>{ 3, 3, 3 });
+  }
+}
+
+#ifdef OPENGLOVES_HAS_MMAP
+TEST_CASE("MappedFile", "[bulk_decoder]") {
+  MappedFile file;
+  REQUIRE_FALSE(file.open("/this/file/does/not/exist"));
+
+  const auto log = makeLog(100);
+  char path[] = "/tmp/opengloves-bulk-XXXXXX";
+  const int fd = mkstemp(path);
+  REQUIRE(fd >= 0);
+  REQUIRE(write(fd, log.data(), log.size()) == static_cast<ssize_t>(log.size()));
+  close(fd);
+
+  REQUIRE(file.open(path));
+  REQUIRE(file.size() == log.size());
+
+  BulkDecoder decoder(2, 128);
+  std::vector<OutputData> output(decoder.countFrames(file.data(), file.size()));
+  REQUIRE(output.size() == 100);
+  decoder.decodeOutput(file.data(), file.size(), output.data(), output.size());
+  REQUIRE(std::holds_alternative<OutputHapticsData>(output[2]));
+
+  file.close();
+  REQUIRE(file.data() == nullptr);
+  unlink(path);
+}
+#endif
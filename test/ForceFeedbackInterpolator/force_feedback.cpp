@@ -0,0 +1,131 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+#include <opengloves/force_feedback.hpp>
+
+#include <cmath>
+
+using namespace opengloves;
+
+namespace {
+  struct Simulation {
+    /// Largest change of the index finger between two ticks
+    float max_step = 0.0F;
+    /// Largest distance of the index finger to the host's (continuous) target
+    float max_error = 0.0F;
+    OutputForceFeedbackData last{};
+  };
+
+  /// The host sends a smooth index finger target at 90 Hz, with up to 2 ms of jitter, through the encoder;
+  /// the device ticks its servos at 1 kHz.
+  auto simulate(ForceFeedbackInterpolator& interpolator, Timestamp duration) -> Simulation {
+    const auto target = [](Timestamp t) {
+      return 0.5F + 0.4F * static_cast<float>(std::sin(6.283185307179586 * static_cast<double>(t) / 1e6));
+    };
+
+    Simulation simulation;
+    std::string buffer(64, '\0');
+    Timestamp next_frame = 0;
+    int frame = 0;
+    bool first_tick = true;
+
+    const Timestamp start = 0xFFFF'0000; // also exercise the wrap-around
+    for (Timestamp t = 0; t < duration; t += 1'000) {
+      if (t >= next_frame) {
+        OutputForceFeedbackData ffb{};
+        ffb.index = target(t);
+
+        const auto written = AlphaEncoding::encodeOutput(ffb, reinterpret_cast<uint8_t*>(buffer.data()), buffer.size());
+        const auto decoded = AlphaEncoding::decodeOutput(reinterpret_cast<const uint8_t*>(buffer.data()), written);
+        interpolator.push(start + t, std::get<OutputForceFeedbackData>(decoded));
+
+        frame++;
+        next_frame = static_cast<Timestamp>(frame) * 11'111 + (frame % 3 == 0 ? 2'000 : 0);
+      }
+
+      const auto output = interpolator.tick(start + t);
+      if (!first_tick) {
+        simulation.max_step = std::max(simulation.max_step, std::abs(output.index - simulation.last.index));
+      }
+      if (t > 100'000) {
+        simulation.max_error = std::max(simulation.max_error, std::abs(output.index - target(t)));
+      }
+      simulation.last = output;
+      first_tick = false;
+    }
+
+    return simulation;
+  }
+} // namespace
+
+TEST_CASE("ForceFeedbackInterpolator", "[force_feedback]") {
+  SECTION("Steps by default") {
+    ForceFeedbackInterpolator interpolator;
+    REQUIRE(interpolator.tick(0) == OutputForceFeedbackData{});
+
+    interpolator.push(0, { .thumb = 0.0F, .index = 0.0F, .middle = 0.0F, .ring = 0.0F, .pinky = 0.0F });
+    interpolator.push(10'000, { .thumb = 1.0F, .index = 0.5F, .middle = 0.0F, .ring = 0.0F, .pinky = 0.0F });
+    REQUIRE(interpolator.interval() == 10'000);
+    REQUIRE(interpolator.tick(10'000) == OutputForceFeedbackData{ .thumb = 1.0F, .index = 0.5F, .middle = 0.0F, .ring = 0.0F, .pinky = 0.0F });
+  }
+
+  SECTION("Interpolation over the frame interval") {
+    ForceFeedbackInterpolatorConfig config{};
+    config.fingers.index.interpolate = true;
+    ForceFeedbackInterpolator interpolator(config);
+
+    interpolator.push(0, {});
+    interpolator.push(10'000, { .thumb = 1.0F, .index = 1.0F, .middle = 0.0F, .ring = 0.0F, .pinky = 0.0F });
+
+    // Per finger: the thumb steps, the index ramps
+    auto output = interpolator.tick(12'500);
+    REQUIRE(output.thumb == 1.0F);
+    REQUIRE(output.index == 0.25F);
+    REQUIRE(interpolator.tick(20'000).index == 1.0F);
+    REQUIRE(interpolator.tick(30'000).index == 1.0F);
+
+    // A frame arriving mid-ramp starts from where the output is
+    interpolator.push(30'000, {});
+    interpolator.tick(32'500);
+    interpolator.push(35'000, { .thumb = 0.0F, .index = 1.0F, .middle = 0.0F, .ring = 0.0F, .pinky = 0.0F });
+    REQUIRE(interpolator.tick(35'000).index == Catch::Approx(0.8F));
+
+    // After a pause, the new stream steps
+    interpolator.push(500'000, {});
+    REQUIRE(interpolator.interval() == 0);
+    REQUIRE(interpolator.tick(500'000).index == 0.0F);
+  }
+
+  SECTION("Slew rate limit") {
+    ForceFeedbackInterpolatorConfig config{};
+    config.fingers.pinky.max_slew_rate = 10.0F;
+    ForceFeedbackInterpolator interpolator(config);
+
+    interpolator.push(0, {});
+    interpolator.tick(0);
+    interpolator.push(1'000, { .thumb = 0.0F, .index = 0.0F, .middle = 0.0F, .ring = 0.0F, .pinky = 1.0F });
+
+    REQUIRE(interpolator.tick(1'000).pinky == Catch::Approx(0.01F));
+    REQUIRE(interpolator.tick(51'000).pinky == Catch::Approx(0.51F));
+    REQUIRE(interpolator.tick(200'000).pinky == 1.0F);
+  }
+
+  SECTION("Host simulation") {
+    ForceFeedbackInterpolator stepping;
+    const auto stepped = simulate(stepping, 2'000'000);
+
+    ForceFeedbackInterpolatorConfig config{};
+    config.fingers.index = { .interpolate = true, .max_slew_rate = 5.0F };
+    ForceFeedbackInterpolator smoothing(config);
+    const auto smoothed = simulate(smoothing, 2'000'000);
+
+    REQUIRE(smoothing.interval() > 10'000);
+    REQUIRE(smoothing.interval() < 12'000);
+
+    // Steps of a 90 Hz stream are up to ~2.8% of the range, and spread over ~11 ticks when interpolating
+    REQUIRE(stepped.max_step > 0.025F);
+    REQUIRE(smoothed.max_step < 0.005F);
+    REQUIRE(smoothed.max_error < 0.06F);
+  }
+}
@@ -0,0 +1,89 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/scheduler.hpp>
+
+#include <functional>
+
+using namespace opengloves;
+
+namespace {
+  /// Simulated clock of a 1 kHz glove loop
+  struct SimulatedLoop {
+    FrameScheduler scheduler;
+    Timestamp now = 0xFFFF'0000; // also exercise the wrap-around
+    int sent = 0;
+
+    /// Run for `duration` microseconds with the input returned by `motion(time since start)`, return the frames sent
+    auto run(Timestamp duration, const std::function<InputPeripheralData(Timestamp)>& motion) -> int {
+      const auto start_sent = this->sent;
+      for (Timestamp t = 0; t < duration; t += 1'000) {
+        this->sent += this->scheduler.poll(this->now, motion(t)) ? 1 : 0;
+        this->now += 1'000;
+      }
+      return this->sent - start_sent;
+    }
+  };
+
+  auto curl(float value) -> InputPeripheralData {
+    InputPeripheralData input;
+    input.curl.index.curl_total = value;
+    return input;
+  }
+} // namespace
+
+TEST_CASE("FrameScheduler", "[scheduler]") {
+  SimulatedLoop loop;
+
+  SECTION("Keep-alive at rest") {
+    REQUIRE(loop.run(1'000'000, [](Timestamp) { return curl(0.5F); }) == 10);
+
+    // Sensor noise does not count as motion
+    REQUIRE(loop.run(1'000'000, [](Timestamp t) { return curl(0.5F + ((t / 1'000) % 2 == 0 ? 0.001F : -0.001F)); }) == 10);
+  }
+
+  SECTION("Full rate during fast motion") {
+    loop.run(100'000, [](Timestamp) { return curl(0.0F); });
+
+    // A full grab in 200 ms
+    REQUIRE(loop.run(200'000, [](Timestamp t) { return curl(static_cast<float>(t) / 200'000.0F); }) == 40);
+  }
+
+  SECTION("Small changes are sent before the keep-alive") {
+    loop.run(1'000, [](Timestamp) { return curl(0.5F); });
+    const auto start = loop.now;
+
+    loop.run(100'000, [](Timestamp) { return curl(0.505F); });
+    const auto delay = elapsed(start, loop.scheduler.lastSent());
+    REQUIRE(delay > 60'000);
+    REQUIRE(delay < 80'000);
+  }
+
+  SECTION("Buttons are sent at the next full-rate slot") {
+    loop.run(1'000, [](Timestamp) { return InputPeripheralData{}; });
+    const auto start = loop.now - 1'000;
+
+    InputPeripheralData pressed;
+    pressed.button_a.press = true;
+    loop.run(50'000, [&pressed](Timestamp) { return pressed; });
+
+    REQUIRE(elapsed(start, loop.scheduler.lastSent()) == 5'000);
+  }
+
+  SECTION("Any motion at full rate") {
+    loop.scheduler = FrameScheduler(FrameSchedulerConfig{ .full_rate_velocity = GENERATE(0.0F, -1.0F) });
+
+    // The keep-alive still runs at rest
+    REQUIRE(loop.run(1'000'000, [](Timestamp) { return curl(0.5F); }) == 10);
+
+    REQUIRE(loop.run(100'000, [](Timestamp t) { return curl(0.5F + static_cast<float>(t) / 1'000'000.0F); }) == 20);
+  }
+
+  SECTION("Reset") {
+    loop.run(1'000, [](Timestamp) { return curl(0.5F); });
+    REQUIRE_FALSE(loop.scheduler.poll(loop.now, curl(0.5F)));
+
+    loop.scheduler.reset();
+    REQUIRE(loop.scheduler.poll(loop.now, curl(0.5F)));
+  }
+}
@@ -0,0 +1,98 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/state_table.hpp>
+
+using namespace opengloves;
+
+TEST_CASE("GloveStateTable", "[state_table]") {
+  GloveStateTable table(3);
+
+  REQUIRE(table.size() == 3);
+  REQUIRE(table.stride() % GloveStateTable::COLUMN_ALIGNMENT == 0);
+  REQUIRE(table.stride() >= table.size());
+
+  SECTION("Starts zeroed") {
+    for (size_t glove = 0; glove < table.size(); glove++) {
+      auto input = table.get(glove);
+      REQUIRE(input.curl == InputPeripheralData().curl);
+      REQUIRE(input.splay == InputPeripheralData().splay);
+      REQUIRE_FALSE(input.joystick.press);
+    }
+  }
+
+  SECTION("Set and get") {
+    InputPeripheralData input;
+    input.curl.index.curl = { 0.25f, 0.5f, 0.75f, 1.0f };
+    input.splay.ring = 0.5f;
+    input.joystick = { .x = 0.1f, .y = 0.2f, .press = true };
+    input.button_menu.press = true;
+    input.grab.press = true;
+    input.grab.value = 0.3f;
+
+    table.set(1, input);
+
+    auto actual = table.get(1);
+    REQUIRE(actual.curl == input.curl);
+    REQUIRE(actual.splay == input.splay);
+    REQUIRE(actual.joystick.x == 0.1f);
+    REQUIRE(actual.joystick.y == 0.2f);
+    REQUIRE(actual.joystick.press);
+    REQUIRE(actual.button_menu.press);
+    REQUIRE_FALSE(actual.button_a.press);
+    REQUIRE(actual.grab.press);
+    REQUIRE(actual.grab.value == 0.3f);
+
+    // Neighbours are untouched
+    REQUIRE(table.get(0).curl == InputPeripheralData().curl);
+    REQUIRE(table.get(2).curl == InputPeripheralData().curl);
+
+    // Columns are contiguous per channel
+    REQUIRE(table.curl(1, 2)[1] == 0.75f);
+    REQUIRE(table.splay(3)[1] == 0.5f);
+    REQUIRE(table.joystickPress()[1]);
+    REQUIRE(table.button(2)[1]);
+    REQUIRE(table.analogButtonValue(1)[1] == 0.3f);
+  }
+
+  SECTION("Decode") {
+    const std::string data = "A4095B0C0D0E0(AAB)4095(EB)4095F4095KI\n";
+
+    REQUIRE(table.decode(2, reinterpret_cast<const uint8_t *>(data.c_str()), data.size()));
+
+    REQUIRE(table.curl(0)[2] == 1.0f);
+    REQUIRE(table.curl(0, 1)[2] == 1.0f);
+    REQUIRE(table.splay(4)[2] == 1.0f);
+    REQUIRE(table.joystickX()[2] == 1.0f);
+    REQUIRE(table.button(1)[2]);
+    REQUIRE(table.analogButtonPress(0)[2]);
+
+    auto input = table.get(2);
+    REQUIRE(input.curl.thumb.curl_total == 1.0f);
+    REQUIRE(input.button_b.press);
+    REQUIRE(input.trigger.press);
+
+    // Next frame fully replaces the state of the glove
+    const std::string next = "A0B4095C0D0E0\n";
+    REQUIRE(table.decode(2, reinterpret_cast<const uint8_t *>(next.c_str()), next.size()));
+
+    input = table.get(2);
+    REQUIRE(input.curl.thumb.curl_total == 0.0f);
+    REQUIRE(input.curl.thumb.curl_joint1 == 0.0f);
+    REQUIRE(input.curl.index.curl_total == 1.0f);
+    REQUIRE_FALSE(input.button_b.press);
+    REQUIRE_FALSE(input.trigger.press);
+
+    REQUIRE_FALSE(table.decode(1, reinterpret_cast<const uint8_t *>("\n"), 1));
+  }
+
+  SECTION("Decode other resolutions") {
+    const std::string data = "A255B0C128\n";
+
+    REQUIRE(table.decode<AlphaEncoding8>(0, reinterpret_cast<const uint8_t *>(data.c_str()), data.size()));
+
+    REQUIRE(table.curl(0)[0] == 1.0f);
+    REQUIRE(table.curl(1)[0] == 0.0f);
+    REQUIRE_THAT(table.curl(2)[0], Catch::Matchers::WithinAbs(128.0f / 255.0f, 0.0001f));
+  }
+}
@@ -0,0 +1,131 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/haptics.hpp>
+
+using namespace opengloves;
+
+namespace {
+  /// Simulated 10 kHz actuator timer
+  template<size_t PoolSize>
+  struct SimulatedTimer {
+    HapticsScheduler<PoolSize>& scheduler;
+    Timestamp now = 0xFFFF'0000; // also exercise the wrap-around
+
+    /// Tick for `duration` microseconds, and return the mean and the peak duty
+    auto run(Timestamp duration) -> std::pair<float, float> {
+      float sum = 0.0F;
+      float peak = 0.0F;
+      int ticks = 0;
+      for (Timestamp t = 0; t < duration; t += 100, ticks++) {
+        const auto duty = this->scheduler.tick(this->now);
+        sum += duty;
+        peak = std::max(peak, duty);
+        this->now += 100;
+      }
+      return { ticks == 0 ? 0.0F : sum / static_cast<float>(ticks), peak };
+    }
+  };
+} // namespace
+
+TEST_CASE("HapticsScheduler", "[haptics]") {
+  HapticsScheduler<4> scheduler;
+  SimulatedTimer<4> timer{ scheduler };
+
+  SECTION("Single effect") {
+    REQUIRE(scheduler.push(timer.now, { .frequency = 100.0F, .duration = 0.05F, .amplitude = 0.8F }));
+
+    // Square wave: on half the time
+    const auto [mean, peak] = timer.run(50'000);
+    REQUIRE(peak == 0.8F);
+    REQUIRE_THAT(mean, Catch::Matchers::WithinAbs(0.4, 0.01));
+
+    REQUIRE(timer.run(10'000).second == 0.0F);
+    REQUIRE_FALSE(scheduler.playing());
+  }
+
+  SECTION("Long effects") {
+    // Longer than the clock can compare, so it is cut to the longest duration instead of ending right away
+    REQUIRE(scheduler.push(timer.now, { .frequency = 0.0F, .duration = 3600.0F, .amplitude = 0.5F }));
+    REQUIRE(scheduler.tick(timer.now + 1'000'000) == 0.5F);
+    REQUIRE(scheduler.playing());
+
+    REQUIRE(scheduler.tick(timer.now + HapticsScheduler<4>::MAX_DURATION - 1) == 0.5F);
+    REQUIRE(scheduler.tick(timer.now + HapticsScheduler<4>::MAX_DURATION) == 0.0F);
+    REQUIRE_FALSE(scheduler.playing());
+  }
+
+  SECTION("Waveforms") {
+    HapticsScheduler<4> constant({ .waveform = HapticsWaveform_Constant });
+    HapticsScheduler<4> sine({ .waveform = HapticsWaveform_Sine });
+    SimulatedTimer<4> constant_timer{ constant };
+    SimulatedTimer<4> sine_timer{ sine };
+
+    constant.push(constant_timer.now, { .frequency = 100.0F, .duration = 0.05F, .amplitude = 0.5F });
+    sine.push(sine_timer.now, { .frequency = 100.0F, .duration = 0.05F, .amplitude = 0.5F });
+
+    REQUIRE_THAT(constant_timer.run(50'000).first, Catch::Matchers::WithinAbs(0.5, 0.001));
+    REQUIRE_THAT(sine_timer.run(50'000).first, Catch::Matchers::WithinAbs(0.25, 0.01));
+  }
+
+  SECTION("Similar effects merge") {
+    scheduler.push(timer.now, { .frequency = 100.0F, .duration = 0.02F, .amplitude = 0.5F });
+    timer.run(10'000);
+    REQUIRE(scheduler.push(timer.now, { .frequency = 105.0F, .duration = 0.02F, .amplitude = 0.7F }));
+    REQUIRE(scheduler.pending() == 0);
+
+    // Extended to 30 ms in total, at the stronger amplitude
+    REQUIRE(timer.run(19'000).second == 0.7F);
+    REQUIRE(scheduler.playing());
+    timer.run(1'100);
+    REQUIRE_FALSE(scheduler.playing());
+  }
+
+  SECTION("Preemption resumes the longer effect") {
+    HapticsScheduler<4> constant({ .waveform = HapticsWaveform_Constant });
+    SimulatedTimer<4> constant_timer{ constant };
+
+    constant.push(constant_timer.now, { .frequency = 50.0F, .duration = 0.1F, .amplitude = 0.3F });
+    constant_timer.run(10'000);
+
+    constant.push(constant_timer.now, { .frequency = 200.0F, .duration = 0.02F, .amplitude = 0.9F });
+    REQUIRE(constant.pending() == 1);
+    REQUIRE_THAT(constant_timer.run(20'000).first, Catch::Matchers::WithinAbs(0.9F, 1e-5));
+
+    // The rest of the long effect, up to its original end
+    REQUIRE_THAT(constant_timer.run(70'000).first, Catch::Matchers::WithinAbs(0.3F, 1e-5));
+    REQUIRE(constant_timer.run(1'000).first == 0.0F);
+  }
+
+  SECTION("Weaker effects wait") {
+    HapticsScheduler<2> constant({ .waveform = HapticsWaveform_Constant });
+    SimulatedTimer<2> constant_timer{ constant };
+
+    constant.push(constant_timer.now, { .frequency = 200.0F, .duration = 0.02F, .amplitude = 0.9F });
+    REQUIRE(constant.push(constant_timer.now, { .frequency = 20.0F, .duration = 0.05F, .amplitude = 0.2F }));
+    REQUIRE(constant.push(constant_timer.now, { .frequency = 50.0F, .duration = 0.03F, .amplitude = 0.4F }));
+
+    // Pool is full, the weakest pending effect makes room for a stronger one only
+    REQUIRE_FALSE(constant.push(constant_timer.now, { .frequency = 10.0F, .duration = 0.05F, .amplitude = 0.1F }));
+    REQUIRE(constant.push(constant_timer.now, { .frequency = 80.0F, .duration = 0.05F, .amplitude = 0.3F }));
+    REQUIRE(constant.pending() == 2);
+
+    REQUIRE_THAT(constant_timer.run(20'000).first, Catch::Matchers::WithinAbs(0.9F, 1e-5));
+    REQUIRE_THAT(constant_timer.run(10'000).first, Catch::Matchers::WithinAbs(0.4F, 1e-5));
+    REQUIRE_THAT(constant_timer.run(20'000).first, Catch::Matchers::WithinAbs(0.3F, 1e-5));
+    REQUIRE(constant_timer.run(100).first == 0.0F);
+    REQUIRE_FALSE(constant.playing());
+  }
+
+  SECTION("Decoded outputs") {
+    REQUIRE(scheduler.handleOutput(timer.now, OutputHapticsData{ .frequency = 100.0F, .duration = 0.01F, .amplitude = 1.0F }));
+    REQUIRE_FALSE(scheduler.handleOutput(timer.now, OutputForceFeedbackData{}));
+    REQUIRE(scheduler.playing());
+
+    // Empty effects are dropped
+    scheduler.stop();
+    REQUIRE_FALSE(scheduler.push(timer.now, { .frequency = 100.0F, .duration = 0.0F, .amplitude = 1.0F }));
+    REQUIRE_FALSE(scheduler.push(timer.now, { .frequency = 100.0F, .duration = 1.0F, .amplitude = 0.0F }));
+    REQUIRE_FALSE(scheduler.playing());
+  }
+}
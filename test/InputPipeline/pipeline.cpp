@@ -0,0 +1,190 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/pipeline.hpp>
+
+using namespace opengloves;
+
+TEST_CASE("kernels", "[pipeline]") {
+  SECTION("mapRange") {
+    std::array<float, 3> values{ 0.2f, 0.5f, 0.7f };
+    std::array<float, 3> min{ 0.2f, 0.0f, 1.0f };
+    std::array<float, 3> max{ 0.6f, 1.0f, 0.0f };
+
+    kernels::mapRange(values.data(), min.data(), max.data(), values.size());
+
+    REQUIRE_THAT(values[0], Catch::Matchers::WithinAbs(0.0f, 1e-6));
+    REQUIRE_THAT(values[1], Catch::Matchers::WithinAbs(0.5f, 1e-6));
+    REQUIRE_THAT(values[2], Catch::Matchers::WithinAbs(0.7f, 1e-6)); // not calibrated
+  }
+
+  SECTION("deadzone") {
+    std::array<float, 5> values{ 0.05f, 0.1f, 0.5f, 0.9f, 0.95f };
+
+    kernels::deadzone(values.data(), 0.1f, values.size());
+
+    REQUIRE(values[0] == 0.0f);
+    REQUIRE_THAT(values[1], Catch::Matchers::WithinAbs(0.0f, 1e-6));
+    REQUIRE_THAT(values[2], Catch::Matchers::WithinAbs(0.5f, 1e-6));
+    REQUIRE_THAT(values[3], Catch::Matchers::WithinAbs(1.0f, 1e-6));
+    REQUIRE(values[4] == 1.0f);
+
+    // Too wide deadzones are clamped, instead of an infinite or negative stretch
+    for (const auto width : { 0.5f, 0.7f }) {
+      std::array<float, 4> wide{ 0.0f, 0.49f, 0.51f, 1.0f };
+      kernels::deadzone(wide.data(), width, wide.size());
+
+      REQUIRE(wide == std::array<float, 4>{ 0.0f, 0.0f, 1.0f, 1.0f });
+    }
+  }
+
+  SECTION("ema") {
+    std::array<float, 2> state{ 0.0f, 1.0f };
+    std::array<float, 2> values{ 1.0f, 1.0f };
+
+    kernels::ema(values.data(), state.data(), 0.25f, values.size());
+
+    REQUIRE(values[0] == 0.25f);
+    REQUIRE(values[1] == 1.0f);
+  }
+
+  SECTION("oneEuro") {
+    std::array<float, 1> state{ 0.0f };
+    std::array<float, 1> derivative{ 0.0f };
+
+    float previous = 0.0f;
+    for (int i = 0; i < 100; i++) {
+      std::array<float, 1> values{ 1.0f };
+      kernels::oneEuro(values.data(), state.data(), derivative.data(), 1.0f, 0.0f, 1.0f, 0.01f, values.size());
+
+      REQUIRE(values[0] >= previous); // converges monotonically to the step
+      REQUIRE(values[0] <= 1.0f);
+      previous = values[0];
+    }
+    REQUIRE(previous > 0.9f);
+
+    // Repeated timestamps keep the state, instead of turning it into NaN for good
+    const auto settled = state[0];
+    for (const auto dt : { 0.0f, -0.01f }) {
+      std::array<float, 1> values{ 0.0f };
+      kernels::oneEuro(values.data(), state.data(), derivative.data(), 1.0f, 0.0f, 1.0f, dt, values.size());
+
+      REQUIRE(values[0] == settled);
+      REQUIRE(state[0] == settled);
+      REQUIRE_FALSE(std::isnan(derivative[0]));
+    }
+
+    std::array<float, 1> values{ 0.0f };
+    kernels::oneEuro(values.data(), state.data(), derivative.data(), 1.0f, 0.0f, 1.0f, 0.01f, values.size());
+    REQUIRE(values[0] < settled);
+  }
+}
+
+TEST_CASE("InputPipeline", "[pipeline]") {
+  InputPipelineConfig config{};
+
+  SECTION("Default config is a passthrough") {
+    InputPipeline pipeline(1, config);
+
+    InputPeripheralData input;
+    input.curl.index.curl = { 0.25f, 0.5f, 0.75f, 1.0f };
+    input.splay.ring = 0.3f;
+    input.joystick.x = 0.7f;
+
+    auto expected = input;
+    pipeline.process(input, 0.01f);
+
+    REQUIRE(input.curl == expected.curl);
+    REQUIRE(input.splay == expected.splay);
+    REQUIRE(input.joystick.x == expected.joystick.x);
+  }
+
+  SECTION("Calibration") {
+    for (auto& finger : config.curl.fingers) {
+      finger.curl_total.calibrate = true;
+    }
+    InputPipeline pipeline(2, config);
+    GloveStateTable table(2);
+
+    pipeline.startCalibration();
+    REQUIRE(pipeline.isCalibrating());
+    for (const auto value : { 0.2f, 0.6f, 0.4f }) {
+      table.curl(1)[0] = value;
+      table.curl(1)[1] = value / 2.0f;
+      pipeline.process(table, 0.01f);
+    }
+    pipeline.stopCalibration();
+
+    table.curl(1)[0] = 0.4f;
+    table.curl(1)[1] = 0.4f;
+    pipeline.process(table, 0.01f);
+
+    REQUIRE_THAT(table.curl(1)[0], Catch::Matchers::WithinAbs(0.5f, 1e-6));
+    REQUIRE_THAT(table.curl(1)[1], Catch::Matchers::WithinAbs(1.0f, 1e-6)); // clamped, glove range is [0.1, 0.3]
+
+    // Not tracked outside of calibration
+    table.curl(1)[0] = 0.8f;
+    pipeline.process(table, 0.01f);
+    REQUIRE(table.curl(1)[0] == 1.0f);
+
+    pipeline.resetCalibration();
+    table.curl(1)[0] = 0.8f;
+    pipeline.process(table, 0.01f);
+    REQUIRE(table.curl(1)[0] == 0.8f);
+  }
+
+  SECTION("Filtering per glove") {
+    config.curl.index.curl_total.filter = FilterType_Ema;
+    config.curl.index.curl_total.ema_alpha = 0.5f;
+    InputPipeline pipeline(2, config);
+
+    InputPeripheralData first;
+    InputPeripheralData second;
+
+    // First frame seeds the filter
+    first.curl.index.curl_total = 1.0f;
+    pipeline.process(first, 0.01f, 0);
+    REQUIRE(first.curl.index.curl_total == 1.0f);
+
+    second.curl.index.curl_total = 0.0f;
+    pipeline.process(second, 0.01f, 1);
+    REQUIRE(second.curl.index.curl_total == 0.0f);
+
+    first.curl.index.curl_total = 0.0f;
+    pipeline.process(first, 0.01f, 0);
+    REQUIRE(first.curl.index.curl_total == 0.5f);
+
+    second.curl.index.curl_total = 1.0f;
+    pipeline.process(second, 0.01f, 1);
+    REQUIRE(second.curl.index.curl_total == 0.5f);
+
+    // Other channels are untouched
+    first.curl.thumb.curl_total = 0.3f;
+    pipeline.process(first, 0.01f, 0);
+    REQUIRE(first.curl.thumb.curl_total == 0.3f);
+  }
+
+  SECTION("Gloves out of range") {
+    config.curl.index.curl_total.filter = FilterType_Ema;
+    config.curl.index.curl_total.ema_alpha = 0.5f;
+    InputPipeline pipeline(2, config);
+
+    // Neither padding nor the next channel's state is touched
+    InputPeripheralData input;
+    input.curl.index.curl_total = 1.0f;
+    for (const size_t glove : { size_t{ 2 }, size_t{ 16 }, size_t{ 1'000'000 } }) {
+      REQUIRE_FALSE(pipeline.process(input, 0.01f, glove));
+      REQUIRE(input.curl.index.curl_total == 1.0f);
+    }
+
+    InputPeripheralData first;
+    first.curl.index.curl_total = 0.25f;
+    REQUIRE(pipeline.process(first, 0.01f, 0));
+    REQUIRE(first.curl.index.curl_total == 0.25f);
+
+    InputPeripheralData second;
+    second.curl.index.curl_total = 0.75f;
+    REQUIRE(pipeline.process(second, 0.01f, 1));
+    REQUIRE(second.curl.index.curl_total == 0.75f);
+  }
+}
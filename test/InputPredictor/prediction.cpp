@@ -0,0 +1,115 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/prediction.hpp>
+
+using namespace opengloves;
+
+auto frame(float curl) -> InputPeripheralData {
+  InputPeripheralData input;
+  input.curl.index.curl_total = curl;
+  input.joystick.x = curl;
+  return input;
+}
+
+TEST_CASE("InputHistory", "[prediction]") {
+  InputHistory<3> history;
+
+  REQUIRE(history.empty());
+  REQUIRE(history.capacity() == 3);
+
+  for (Timestamp t = 1; t <= 5; t++) {
+    history.push(t, frame(0.0f));
+  }
+
+  REQUIRE(history.size() == 3);
+  REQUIRE(history.newest().timestamp == 5);
+  REQUIRE(history.fromNewest(1).timestamp == 4);
+  REQUIRE(history.oldest().timestamp == 3);
+
+  history.clear();
+  REQUIRE(history.empty());
+}
+
+TEST_CASE("InputPredictor", "[prediction]") {
+  PredictionConfig config;
+  config.mode = PredictionMode_Linear;
+  config.max_horizon = 40'000;
+
+  InputPredictor<2> predictor(config);
+
+  REQUIRE(predictor.predict(0).curl.index.curl_total == 0.0f);
+
+  // 0.1 per 10ms
+  predictor.push(100'000, frame(0.2f));
+  REQUIRE(predictor.predict(120'000).curl.index.curl_total == 0.2f);
+
+  predictor.push(110'000, frame(0.3f));
+
+  SECTION("Linear") {
+    REQUIRE_THAT(predictor.predict(110'000).curl.index.curl_total, Catch::Matchers::WithinAbs(0.3f, 1e-6));
+    REQUIRE_THAT(predictor.predict(120'000).curl.index.curl_total, Catch::Matchers::WithinAbs(0.4f, 1e-6));
+    REQUIRE_THAT(predictor.predict(130'000).joystick.x, Catch::Matchers::WithinAbs(0.5f, 1e-6));
+
+    // Limited by the horizon
+    REQUIRE_THAT(predictor.predict(200'000).curl.index.curl_total, Catch::Matchers::WithinAbs(0.7f, 1e-6));
+
+    // Clamped to the channel range
+    predictor.setConfig({ .mode = PredictionMode_Linear, .damping_time = 0.0f, .max_horizon = 1'000'000 });
+    REQUIRE(predictor.predict(300'000).curl.index.curl_total == 1.0f);
+
+    // Channels without motion stay put
+    REQUIRE(predictor.predict(120'000).curl.thumb.curl_total == 0.0f);
+  }
+
+  SECTION("Interpolation") {
+    REQUIRE_THAT(predictor.predict(105'000).curl.index.curl_total, Catch::Matchers::WithinAbs(0.25f, 1e-6));
+    REQUIRE_THAT(predictor.predict(50'000).curl.index.curl_total, Catch::Matchers::WithinAbs(0.2f, 1e-6));
+  }
+
+  SECTION("Velocity damped") {
+    predictor.setConfig({ .mode = PredictionMode_VelocityDamped, .damping_time = 10'000.0f, .max_horizon = 1'000'000 });
+
+    const auto near = predictor.predict(111'000).curl.index.curl_total;
+    const auto far = predictor.predict(1'000'000).curl.index.curl_total;
+
+    REQUIRE_THAT(near, Catch::Matchers::WithinAbs(0.3095f, 1e-3)); // almost linear for short horizons
+    REQUIRE_THAT(far, Catch::Matchers::WithinAbs(0.4f, 1e-3));     // levels off at velocity * damping_time
+
+    // No damping time holds the newest frame, even at a zero horizon
+    for (const auto damping_time : { 0.0f, -1.0f }) {
+      predictor.setConfig({ .mode = PredictionMode_VelocityDamped, .damping_time = damping_time, .max_horizon = 1'000'000 });
+      for (const Timestamp timestamp : { 110'000U, 120'000U }) {
+        const auto predicted = predictor.predict(timestamp);
+        REQUIRE(predicted.curl.index.curl_total == 0.3f);
+        REQUIRE(predicted.joystick.x == 0.3f);
+      }
+    }
+  }
+
+  SECTION("Hold") {
+    predictor.setConfig({ .mode = PredictionMode_Hold });
+    REQUIRE(predictor.predict(130'000).curl.index.curl_total == 0.3f);
+  }
+
+  SECTION("Out of order frames are dropped") {
+    predictor.push(105'000, frame(1.0f));
+    REQUIRE(predictor.history().newest().timestamp == 110'000);
+  }
+
+  SECTION("Timestamp wrap-around") {
+    predictor.reset();
+    predictor.push(0xFFFF'FFFF - 4'999, frame(0.2f));
+    predictor.push(5'000, frame(0.3f));
+
+    REQUIRE_THAT(predictor.predict(15'000).curl.index.curl_total, Catch::Matchers::WithinAbs(0.4f, 1e-6));
+  }
+
+  SECTION("Digital channels follow the newest frame") {
+    auto input = frame(0.4f);
+    input.button_a.press = true;
+    predictor.push(120'000, input);
+
+    REQUIRE(predictor.predict(130'000).button_a.press);
+  }
+}
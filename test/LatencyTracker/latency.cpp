@@ -0,0 +1,116 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/latency.hpp>
+
+using namespace opengloves;
+
+TEST_CASE("LatencyHistogram", "[latency]") {
+  LatencyHistogram histogram;
+
+  REQUIRE(histogram.count() == 0);
+  REQUIRE(histogram.min() == 0);
+  REQUIRE(histogram.percentile(0.5f) == 0);
+
+  REQUIRE(LatencyHistogram::bucketOf(0) == 0);
+  REQUIRE(LatencyHistogram::bucketOf(1) == 1);
+  REQUIRE(LatencyHistogram::bucketOf(3) == 2);
+  REQUIRE(LatencyHistogram::bucketOf(1024) == 11);
+  REQUIRE(LatencyHistogram::bucketOf(0xFFFF'FFFF) == LatencyHistogram::BUCKET_COUNT - 1);
+
+  for (int i = 0; i < 90; i++) {
+    histogram.record(1'000);
+  }
+  for (int i = 0; i < 10; i++) {
+    histogram.record(20'000);
+  }
+  histogram.record(-5);
+
+  REQUIRE(histogram.count() == 101);
+  REQUIRE(histogram.min() == 0);
+  REQUIRE(histogram.max() == 20'000);
+  REQUIRE(histogram.mean() == (90 * 1'000 + 10 * 20'000) / 101);
+  REQUIRE(histogram.buckets()[LatencyHistogram::bucketOf(1'000)] == 90);
+
+  REQUIRE(histogram.percentile(0.5f) == 1'024);
+  REQUIRE(histogram.percentile(0.95f) == 20'000);
+  REQUIRE(histogram.percentile(1.0f) == 20'000);
+
+  histogram.reset();
+  REQUIRE(histogram.count() == 0);
+}
+
+TEST_CASE("LatencyTracker", "[latency]") {
+  LatencyTracker device;
+  LatencyTracker host;
+
+  SECTION("Stamp") {
+    auto first = device.stamp(100);
+    auto second = device.stamp(200);
+
+    REQUIRE(first.sequence == 0U);
+    REQUIRE(second.sequence == 1U);
+    REQUIRE(second.timestamp == 200U);
+    REQUIRE_FALSE(second.echo_timestamp.has_value());
+  }
+
+  SECTION("One-way and round-trip") {
+    host.receive(device.stamp(1'000), 1'500);
+    REQUIRE(host.oneWay().count() == 1);
+    REQUIRE(host.oneWay().max() == 500);
+
+    // Host echoes the newest device timestamp back
+    auto reply = host.stamp(1'600);
+    REQUIRE(reply.echo_timestamp == 1'000U);
+
+    device.receive(reply, 2'100);
+    REQUIRE(device.roundTrip().count() == 1);
+    REQUIRE(device.roundTrip().max() == 1'100);
+    REQUIRE(device.oneWay().max() == 500);
+  }
+
+  SECTION("Loss, reordering and duplicates") {
+    auto receive = [&host](std::uint32_t sequence) {
+      FrameMetadata metadata{};
+      metadata.sequence = sequence;
+      host.receive(metadata, 0);
+    };
+
+    receive(10);
+    receive(11);
+    receive(14); // 12, 13 are missing
+    REQUIRE(host.statistics().lost == 2);
+
+    receive(12); // late
+    REQUIRE(host.statistics().lost == 1);
+    REQUIRE(host.statistics().reordered == 1);
+
+    receive(12);
+    receive(14);
+    REQUIRE(host.statistics().duplicates == 2);
+
+    receive(15);
+    receive(200);
+    receive(16); // too old to tell, stays lost
+    REQUIRE(host.statistics().received == 9);
+    REQUIRE(host.statistics().lost == 1 + 184); // 16 to 199
+    REQUIRE(host.statistics().reordered == 1);
+    REQUIRE(host.statistics().duplicates == 2);
+
+    // Half the sequence space behind
+    host.reset();
+    receive(0x8000'0000);
+    receive(0);
+    REQUIRE(host.statistics().lost == 0);
+    REQUIRE(host.statistics().reordered == 0);
+    REQUIRE(host.statistics().duplicates == 0);
+
+    // Sequence numbers wrap around
+    host.reset();
+    receive(0xFFFF'FFFF);
+    receive(0);
+    receive(2);
+    REQUIRE(host.statistics().lost == 1);
+    REQUIRE(host.statistics().reordered == 0);
+  }
+}
@@ -0,0 +1,116 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+#include <opengloves/latency.hpp>
+
+#if __has_include(<pty.h>)
+#include <pty.h>
+#define OPENGLOVES_HAS_PTY
+#elif __has_include(<util.h>)
+#include <util.h>
+#define OPENGLOVES_HAS_PTY
+#endif
+
+#ifdef OPENGLOVES_HAS_PTY
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+using namespace opengloves;
+
+#ifdef OPENGLOVES_HAS_PTY
+
+namespace {
+  /// Read a single `\n`-terminated frame
+  auto readFrame(int fd) -> std::string {
+    std::string frame;
+    char c = '\0';
+    while (read(fd, &c, 1) == 1) {
+      frame += c;
+      if (c == '\n') {
+        break;
+      }
+    }
+    return frame;
+  }
+
+  auto writeFrame(int fd, const std::string& frame) -> void {
+    REQUIRE(write(fd, frame.data(), frame.size()) == static_cast<ssize_t>(frame.size()));
+  }
+} // namespace
+
+TEST_CASE("LatencyTracker over a pseudo-terminal", "[latency]") {
+  int glove_fd = -1;
+  int host_fd = -1;
+  REQUIRE(openpty(&glove_fd, &host_fd, nullptr, nullptr, nullptr) == 0);
+
+  // No echo, no line ending translation
+  termios attributes{};
+  REQUIRE(tcgetattr(host_fd, &attributes) == 0);
+  cfmakeraw(&attributes);
+  REQUIRE(tcsetattr(host_fd, TCSANOW, &attributes) == 0);
+
+  LatencyTracker glove;
+  LatencyTracker host;
+  std::string buffer(256, '\0');
+
+  // Simulated clock: 2 ms glove -> host, 1 ms host -> glove, glove drops every 5th frame
+  Timestamp now = 0xFFFF'0000; // also exercise the wrap-around
+  for (int i = 0; i < 100; i++) {
+    now += 10'000;
+
+    InputPeripheralData input;
+    input.curl.index.curl_total = static_cast<float>(i % 10) / 10.0f;
+
+    auto metadata = glove.stamp(now);
+    auto written = AlphaEncoding::encodeInput(input, metadata, reinterpret_cast<uint8_t*>(buffer.data()), buffer.size());
+    if (i % 5 == 4) {
+      continue;
+    }
+    writeFrame(glove_fd, buffer.substr(0, written));
+
+    const auto received = readFrame(host_fd);
+    REQUIRE(received == buffer.substr(0, written));
+
+    const auto* data = reinterpret_cast<const uint8_t*>(received.data());
+    REQUIRE(std::holds_alternative<InputPeripheralData>(AlphaEncoding::decodeInput(data, received.size())));
+    host.receive(AlphaEncoding::decodeMetadata(data, received.size()), now + 2'000);
+
+    // FFB reply
+    OutputForceFeedbackData ffb{ .thumb = 0.5f, .index = 0.5f, .middle = 0.5f, .ring = 0.5f, .pinky = 0.5f };
+    written = AlphaEncoding::encodeOutput(ffb, host.stamp(now + 2'500), reinterpret_cast<uint8_t*>(buffer.data()), buffer.size());
+    writeFrame(host_fd, buffer.substr(0, written));
+
+    const auto reply = readFrame(glove_fd);
+    REQUIRE(reply == buffer.substr(0, written));
+
+    const auto* reply_data = reinterpret_cast<const uint8_t*>(reply.data());
+    REQUIRE(std::holds_alternative<OutputForceFeedbackData>(AlphaEncoding::decodeOutput(reply_data, reply.size())));
+    glove.receive(AlphaEncoding::decodeMetadata(reply_data, reply.size()), now + 3'500);
+  }
+
+  close(glove_fd);
+  close(host_fd);
+
+  REQUIRE(host.statistics().received == 80);
+  REQUIRE(host.statistics().lost == 19); // the last drop is not detected until the next frame
+  REQUIRE(host.statistics().reordered == 0);
+  REQUIRE(host.oneWay().min() == 2'000);
+  REQUIRE(host.oneWay().max() == 2'000);
+
+  REQUIRE(glove.statistics().received == 80);
+  REQUIRE(glove.statistics().lost == 0);
+  REQUIRE(glove.oneWay().max() == 1'000);
+  REQUIRE(glove.roundTrip().count() == 80);
+  REQUIRE(glove.roundTrip().min() == 3'500);
+  REQUIRE(glove.roundTrip().max() == 3'500);
+}
+
+#else
+
+TEST_CASE("LatencyTracker over a pseudo-terminal", "[latency]") {
+  SKIP("Pseudo-terminals are not available on this platform");
+}
+
+#endif
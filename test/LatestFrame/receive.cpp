@@ -0,0 +1,90 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+#include <opengloves/receive.hpp>
+
+using namespace opengloves;
+
+namespace {
+  auto bytes(const std::string& data) -> const uint8_t* { return reinterpret_cast<const uint8_t*>(data.data()); }
+} // namespace
+
+TEST_CASE("findLatestFrame", "[receive]") {
+  SECTION("Backlog with an incomplete frame") {
+    const std::string buffer = "A1\nA2\n\nA3\nA4";
+    const auto latest = findLatestFrame(bytes(buffer), buffer.size());
+
+    REQUIRE(std::string(reinterpret_cast<const char*>(latest.data), latest.size) == "A3\n");
+    REQUIRE(latest.dropped == 2);
+    REQUIRE(latest.consumed == buffer.size() - 2);
+  }
+
+  SECTION("Trailing empty lines") {
+    const std::string buffer = "A1\nA2\n\n\n";
+    const auto latest = findLatestFrame(bytes(buffer), buffer.size());
+
+    REQUIRE(std::string(reinterpret_cast<const char*>(latest.data), latest.size) == "A2\n");
+    REQUIRE(latest.dropped == 1);
+    REQUIRE(latest.consumed == buffer.size());
+  }
+
+  SECTION("No complete frame") {
+    for (const std::string buffer : { "", "A1", "\n\n" }) {
+      const auto latest = findLatestFrame(bytes(buffer), buffer.size());
+
+      REQUIRE(latest.data == nullptr);
+      REQUIRE(latest.dropped == 0);
+      REQUIRE(latest.consumed == (buffer == "\n\n" ? 2 : 0));
+    }
+  }
+}
+
+TEST_CASE("LatestFrameDecoder", "[receive]") {
+  SECTION("Input") {
+    const std::string buffer = "A4095\nB4095\nC4095\nD40";
+    const auto latest = LatestFrameDecoder<>::decodeInput(bytes(buffer), buffer.size());
+
+    REQUIRE(std::holds_alternative<InputPeripheralData>(latest.value));
+    const auto& input = std::get<InputPeripheralData>(latest.value);
+    REQUIRE(input.curl.middle.curl_total == 1.0F);
+    REQUIRE(input.curl.index.curl_total == 0.0F);
+    REQUIRE(latest.dropped == 2);
+  }
+
+  SECTION("Output without merging") {
+    const std::string buffer = "A4095B4095C4095D4095E4095\nA0\n";
+    const auto latest = LatestFrameDecoder<>::decodeOutput(bytes(buffer), buffer.size());
+
+    REQUIRE(latest.value == OutputData(OutputForceFeedbackData{ .thumb = 0.0F, .index = 0.0F, .middle = 0.0F, .ring = 0.0F, .pinky = 0.0F }));
+    REQUIRE(latest.dropped == 1);
+  }
+
+  SECTION("Force feedback partial updates") {
+    // Haptics in between are of another kind, and are not merged into force feedback
+    const std::string buffer = "A4095B4095C4095D4095E4095\nF100.00G0.50H1.00\nE0\nA0\nB0C0\n";
+    const auto latest = LatestFrameDecoder<>::decodeOutput(bytes(buffer), buffer.size(), true);
+
+    REQUIRE(latest.dropped == 4);
+    REQUIRE(std::holds_alternative<OutputForceFeedbackData>(latest.value));
+    REQUIRE(
+        std::get<OutputForceFeedbackData>(latest.value)
+        == OutputForceFeedbackData{ .thumb = 0.0F, .index = 0.0F, .middle = 0.0F, .ring = 1.0F, .pinky = 0.0F }
+    );
+  }
+
+  SECTION("Haptics partial updates") {
+    const std::string buffer = "F100.00G0.50H1.00\nA0\nH0.25\n";
+    const auto latest = LatestFrameDecoder<>::decodeOutput(bytes(buffer), buffer.size(), true);
+
+    REQUIRE(latest.value == OutputData(OutputHapticsData{ .frequency = 100.0F, .duration = 0.5F, .amplitude = 0.25F }));
+  }
+
+  SECTION("Nothing to decode") {
+    const std::string buffer = "A4095";
+    const auto latest = LatestFrameDecoder<>::decodeOutput(bytes(buffer), buffer.size(), true);
+
+    REQUIRE(std::holds_alternative<OutputInvalid>(latest.value));
+    REQUIRE(latest.consumed == 0);
+  }
+}
@@ -0,0 +1,132 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+#include <opengloves/link.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace opengloves;
+
+namespace {
+  // Close to the wrap-around of the microsecond clock
+  constexpr Timestamp START = 0xFFFF'0000;
+
+  auto sendString(LinkSimulator& link, Timestamp now, const std::string& frame) -> bool {
+    return link.send(now, reinterpret_cast<const uint8_t*>(frame.data()), frame.size());
+  }
+
+  auto receiveAll(LinkSimulator& link, Timestamp now, std::vector<std::int32_t>* latencies = nullptr) -> std::vector<std::string> {
+    std::vector<std::string> frames;
+    link.receive(now, [&](const uint8_t* frame, size_t frame_size, std::int32_t latency) {
+      frames.emplace_back(reinterpret_cast<const char*>(frame), frame_size);
+      if (latencies != nullptr) {
+        latencies->push_back(latency);
+      }
+    });
+    return frames;
+  }
+} // namespace
+
+TEST_CASE("LinkSimulator", "[link]") {
+  SECTION("Byte stream") {
+    // 115200 baud 8N1: 10 bytes are 100 bits, 868.06 us
+    LinkSimulator link;
+    REQUIRE(link.transmissionTime(10) == 869);
+
+    REQUIRE(sendString(link, START, "A4095B0C0\n"));
+    REQUIRE(sendString(link, START, "A0B4095C0\n"));
+    REQUIRE(link.queued(START) == 20);
+
+    // Nothing arrives before the last bit
+    REQUIRE(receiveAll(link, START + 868).empty());
+
+    std::vector<std::int32_t> latencies;
+    REQUIRE(receiveAll(link, START + 869, &latencies) == std::vector<std::string>{ "A4095B0C0\n" });
+    REQUIRE(link.queued(START + 869) == 10);
+
+    // The second frame queued behind the first
+    REQUIRE(receiveAll(link, START + 10'000, &latencies) == std::vector<std::string>{ "A0B4095C0\n" });
+    REQUIRE(latencies == std::vector<std::int32_t>{ 869, 2 * 869 });
+    REQUIRE(link.queued(START + 10'000) == 0);
+
+    // An idle link starts right away
+    REQUIRE(sendString(link, START + 20'000, "A4095B0C0\n"));
+    latencies.clear();
+    REQUIRE(receiveAll(link, START + 30'000, &latencies).size() == 1);
+    REQUIRE(latencies == std::vector<std::int32_t>{ 869 });
+
+    REQUIRE(link.sent() == 3);
+    REQUIRE(link.delivered() == 3);
+    REQUIRE(link.dropped() == 0);
+    REQUIRE(link.latency().max() == 2 * 869);
+  }
+
+  SECTION("Packets") {
+    // 20 byte packets with 10 bytes of overhead each, at 1 Mbit/s and 8 bits per byte
+    LinkSimulator link({ .baud_rate = 1'000'000, .bits_per_byte = 8, .mtu = 20, .packet_overhead = 10 });
+    const std::string frame(50, 'A');
+
+    // 30, 30 and 20 bytes on the wire
+    REQUIRE(link.transmissionTime(50) == 240 + 240 + 160);
+    REQUIRE(link.transmissionTime(40) == 240 + 240);
+
+    std::vector<std::int32_t> latencies;
+    REQUIRE(sendString(link, START, frame));
+    REQUIRE(receiveAll(link, START + 1'000, &latencies).size() == 1);
+    REQUIRE(latencies == std::vector<std::int32_t>{ 640 });
+  }
+
+  SECTION("Packet interval") {
+    // At most one packet per 7.5 ms, like a BLE connection interval with one notification per event
+    LinkSimulator link({ .baud_rate = 1'000'000, .bits_per_byte = 8, .mtu = 20, .packet_overhead = 10, .packet_interval = 7'500 });
+    const std::string frame(50, 'A');
+
+    REQUIRE(sendString(link, START, frame));
+    // The first packet of this frame waits for the next slot after the three of the first frame
+    REQUIRE(sendString(link, START + 1'000, "A0\n"));
+
+    std::vector<std::int32_t> latencies;
+    REQUIRE(receiveAll(link, START + 100'000, &latencies).size() == 2);
+    REQUIRE(latencies == std::vector<std::int32_t>{ 15'000 + 160, 22'500 + 104 - 1'000 });
+
+    // A long idle link still keeps the interval from the last packet, but no more
+    REQUIRE(sendString(link, START + 200'000, "A0\n"));
+    latencies.clear();
+    REQUIRE(receiveAll(link, START + 300'000, &latencies).size() == 1);
+    REQUIRE(latencies == std::vector<std::int32_t>{ 104 });
+  }
+
+  SECTION("Transmit buffer") {
+    LinkSimulator link({ .queue_size = 25 });
+
+    REQUIRE(sendString(link, START, "A4095B0C0\n"));
+    REQUIRE(sendString(link, START, "A4095B0C0\n"));
+    REQUIRE_FALSE(sendString(link, START, "A4095B0C0\n"));
+
+    // Once the first frame is out, there is room again, whether or not it was received yet
+    REQUIRE(sendString(link, START + 869, "A4095B0C0\n"));
+
+    REQUIRE(receiveAll(link, START + 100'000).size() == 3);
+    REQUIRE(link.sent() == 3);
+    REQUIRE(link.dropped() == 1);
+  }
+
+  SECTION("Encoded frames") {
+    LinkSimulator link({ .baud_rate = 921'600 });
+
+    const OutputData output = OutputForceFeedbackData{ .thumb = 0.25F, .index = 0.5F, .middle = 0.75F, .ring = 1.0F, .pinky = 0.0F };
+    std::string buffer(64, '\0');
+    const auto written = AlphaEncoding::encodeOutput(output, reinterpret_cast<uint8_t*>(buffer.data()), static_cast<int>(buffer.size()));
+    REQUIRE(link.send(START, reinterpret_cast<const uint8_t*>(buffer.data()), static_cast<size_t>(written)));
+
+    std::vector<OutputData> received;
+    link.receive(START + link.transmissionTime(static_cast<size_t>(written)), [&received](const uint8_t* frame, size_t frame_size, std::int32_t) {
+      received.push_back(AlphaEncoding::decodeOutput(frame, frame_size));
+    });
+
+    REQUIRE(received.size() == 1);
+    REQUIRE(received[0] == AlphaEncoding::decodeOutput(reinterpret_cast<const uint8_t*>(buffer.data()), static_cast<size_t>(written)));
+  }
+}
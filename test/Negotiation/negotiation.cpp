@@ -0,0 +1,194 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+#include <opengloves/negotiation.hpp>
+
+#if __has_include(<unistd.h>)
+#include <fcntl.h>
+#include <unistd.h>
+#define OPENGLOVES_HAS_PIPE
+#endif
+
+using namespace opengloves;
+
+TEST_CASE("negotiateSubscription", "[negotiation]") {
+  InputInfoData advertised{ .hand = Hand_Left, .device_type = DeviceType_LucidGloves, .firmware_version = 1 };
+
+  SECTION("Legacy device") {
+    OutputSubscriptionData wanted{ .channels = InputChannel_Curl, .rate = 60, .resolution = 8 };
+    REQUIRE(negotiateSubscription(advertised, wanted) == wanted);
+  }
+
+  SECTION("Clamped to the advertisement") {
+    advertised.channels = InputChannel_Curl | InputChannel_Splay;
+    advertised.max_rate = 120;
+
+    auto subscription = negotiateSubscription(advertised, { .channels = InputChannel_All, .rate = 500, .resolution = 10 });
+    REQUIRE(subscription.channels == (InputChannel_Curl | InputChannel_Splay));
+    REQUIRE(subscription.rate == 120);
+    REQUIRE(subscription.resolution == 10);
+
+    // As fast as possible means as fast as the device goes
+    REQUIRE(negotiateSubscription(advertised, { .channels = InputChannel_Curl, .rate = 0, .resolution = 0 }).rate == 120);
+  }
+}
+
+TEST_CASE("SubscribedInputEncoder rate", "[negotiation]") {
+  SubscribedInputEncoder device(InputInfoData{ .hand = Hand_Left, .device_type = DeviceType_LucidGloves, .firmware_version = 1 });
+  REQUIRE(device.handleOutput(OutputSubscriptionData{ .channels = InputChannel_Curl, .rate = 100, .resolution = 0 }));
+  REQUIRE_FALSE(device.handleOutput(OutputForceFeedbackData{}));
+
+  std::string buffer(256, '\0');
+  auto encode = [&](Timestamp now) {
+    return device.encode(now, InputPeripheralData{}, reinterpret_cast<uint8_t*>(buffer.data()), buffer.size());
+  };
+
+  // 1 kHz loop around the wrap-around, 100 Hz subscription
+  int frames = 0;
+  for (Timestamp now = 0xFFFF'0000; now != 0xFFFF'0000 + 1'000'000; now += 1'000) {
+    frames += encode(now) > 0 ? 1 : 0;
+  }
+  REQUIRE(frames == 100);
+
+  // A stalled loop resumes with a single frame instead of a burst
+  REQUIRE(encode(0x0010'0000) > 0);
+  REQUIRE(encode(0x0010'0000 + 1'000) == 0);
+}
+
+TEST_CASE("SubscribedInputEncoder resolution", "[negotiation]") {
+  SubscribedInputEncoder<AlphaEncoding10> device(InputInfoData{ .hand = Hand_Left, .device_type = DeviceType_LucidGloves, .firmware_version = 1 });
+
+  InputPeripheralData input;
+  input.curl.index.curl_total = 1.0F;
+
+  std::string buffer(256, '\0');
+  const auto written = device.encode(0, input, reinterpret_cast<uint8_t*>(buffer.data()), buffer.size());
+  REQUIRE(buffer.substr(0, static_cast<size_t>(written)) == "A0B1023C0D0E0\n");
+
+  REQUIRE(device.encodeInfo(reinterpret_cast<uint8_t*>(buffer.data()), buffer.size()) > 0);
+}
+
+#ifdef OPENGLOVES_HAS_PIPE
+
+namespace {
+  auto writeAll(int fd, const uint8_t* data, int size) -> void {
+    REQUIRE(size > 0);
+    REQUIRE(write(fd, data, static_cast<size_t>(size)) == static_cast<ssize_t>(size));
+  }
+
+  /// Split everything currently in the pipe into frames
+  auto readFrames(int fd) -> std::vector<std::string> {
+    std::vector<std::string> frames;
+    std::string pending;
+    std::array<char, 4096> chunk{};
+
+    ssize_t n = 0;
+    while ((n = read(fd, chunk.data(), chunk.size())) > 0) {
+      pending.append(chunk.data(), static_cast<size_t>(n));
+    }
+
+    size_t begin = 0;
+    for (size_t end = pending.find('\n'); end != std::string::npos; end = pending.find('\n', begin)) {
+      frames.push_back(pending.substr(begin, end - begin + 1));
+      begin = end + 1;
+    }
+    return frames;
+  }
+
+  struct Pipe {
+    std::array<int, 2> fds{ -1, -1 };
+
+    Pipe() {
+      REQUIRE(pipe(fds.data()) == 0);
+      REQUIRE(fcntl(fds[0], F_SETFL, O_NONBLOCK) == 0); // NOLINT(*-vararg)
+    }
+
+    ~Pipe() {
+      close(fds[0]);
+      close(fds[1]);
+    }
+
+    [[nodiscard]] auto reader() const -> int { return fds[0]; }
+    [[nodiscard]] auto writer() const -> int { return fds[1]; }
+  };
+} // namespace
+
+TEST_CASE("Negotiation between host and device over a pipe", "[negotiation]") {
+  Pipe to_host;
+  Pipe to_device;
+  std::array<uint8_t, 256> buffer{};
+
+  InputInfoData device_info{ .hand = Hand_Right, .device_type = DeviceType_LucidGloves, .firmware_version = 3 };
+  device_info.channels = InputChannel_Curl | InputChannel_CurlJoints | InputChannel_Splay | InputChannel_Buttons;
+  device_info.max_rate = 200;
+  SubscribedInputEncoder device(device_info);
+
+  InputPeripheralData input;
+  input.curl.index.curl_total = 0.5F;
+  input.curl.index.curl[1] = 0.25F;
+  input.splay.index = 0.75F;
+  input.button_a.press = true;
+  input.joystick.x = 1.0F;
+
+  auto stream = [&](Timestamp duration) -> std::vector<std::string> {
+    for (Timestamp now = 0; now < duration; now += 1'000) {
+      const auto written = device.encode(now, input, buffer.data(), buffer.size());
+      if (written > 0) {
+        writeAll(to_host.writer(), buffer.data(), written);
+      }
+    }
+    return readFrames(to_host.reader());
+  };
+
+  // Device announces itself, and streams everything it has until the host answers
+  writeAll(to_host.writer(), buffer.data(), device.encodeInfo(buffer.data(), buffer.size()));
+  auto frames = readFrames(to_host.reader());
+  REQUIRE(frames.size() == 1);
+
+  auto info = AlphaEncoding::decodeInput(reinterpret_cast<const uint8_t*>(frames[0].data()), frames[0].size());
+  REQUIRE(std::holds_alternative<InputInfoData>(info));
+  const auto& advertised = std::get<InputInfoData>(info);
+  REQUIRE(advertised.channels == device_info.channels);
+  REQUIRE(advertised.max_rate == 200);
+
+  const auto unsubscribed = stream(100'000);
+  REQUIRE(unsubscribed.size() == 20);
+
+  // Host only needs the total curl of each finger and the buttons, at 8 bits and 50 Hz
+  const auto subscription = negotiateSubscription(
+      advertised, { .channels = InputChannel_Curl | InputChannel_Buttons | InputChannel_Joystick, .rate = 50, .resolution = 8 }
+  );
+  REQUIRE(subscription.channels == (InputChannel_Curl | InputChannel_Buttons));
+
+  writeAll(to_device.writer(), buffer.data(), AlphaEncoding::encodeOutput(subscription, buffer.data(), buffer.size()));
+  for (const auto& frame : readFrames(to_device.reader())) {
+    REQUIRE(device.handleOutput(AlphaEncoding::decodeOutput(reinterpret_cast<const uint8_t*>(frame.data()), frame.size())));
+  }
+  REQUIRE(device.subscription() == subscription);
+
+  const auto subscribed = stream(100'000);
+  REQUIRE(subscribed.size() == 5);
+  REQUIRE(subscribed.front().size() < unsubscribed.front().size());
+
+  for (const auto& frame : subscribed) {
+    InputPeripheralData decoded;
+    REQUIRE(AlphaEncoding::decodeInputPeripheral(
+        reinterpret_cast<const uint8_t*>(frame.data()), frame.size(), decoded, subscription.resolution
+    ));
+
+    REQUIRE_THAT(decoded.curl.index.curl_total, Catch::Matchers::WithinAbs(0.5, 1.0 / 255));
+    REQUIRE(decoded.curl.index.curl[1] == 0.0F);
+    REQUIRE(decoded.splay.index == 0.0F);
+    REQUIRE(decoded.joystick.x == 0.0F);
+    REQUIRE(decoded.button_a.press);
+  }
+}
+
+#else
+
+TEST_CASE("Negotiation between host and device over a pipe", "[negotiation]") {
+  SKIP("Pipes are not available on this platform");
+}
+
+#endif
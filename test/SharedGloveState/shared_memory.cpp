@@ -0,0 +1,174 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/shared_memory.hpp>
+
+#ifdef OPENGLOVES_HAS_SHARED_MEMORY
+
+#include <string>
+#include <thread>
+
+#include <sys/wait.h>
+
+using namespace opengloves;
+
+namespace {
+  auto segmentName() -> std::string { return "/opengloves-test-" + std::to_string(getpid()); }
+} // namespace
+
+TEST_CASE("SharedGloveState", "[shared_memory]") {
+  const auto name = segmentName();
+
+  SharedGloveState publisher;
+  REQUIRE(publisher.create(name.c_str(), 2));
+
+  SharedGloveState reader;
+  REQUIRE(reader.open(name.c_str()));
+  REQUIRE(reader.gloveCount() == 2);
+
+  SECTION("Snapshots") {
+    InputPeripheralData input;
+    REQUIRE(reader.read(1, input) == 0);
+
+    InputPeripheralData published;
+    published.curl.index.curl_total = 0.5F;
+    published.button_a.press = true;
+    publisher.publish(1, published);
+
+    const auto sequence = reader.read(1, input);
+    REQUIRE(sequence != 0);
+    REQUIRE(input.curl.index.curl_total == 0.5F);
+    REQUIRE(input.button_a.press);
+
+    // Other gloves and directions are independent
+    REQUIRE(reader.read(0, input) == 0);
+
+    OutputData output;
+    REQUIRE(reader.read(1, output) == 0);
+    publisher.publish(1, OutputData(OutputHapticsData{ .frequency = 100.0F, .duration = 0.5F, .amplitude = 1.0F }));
+    REQUIRE(reader.read(1, output) != 0);
+    REQUIRE(output == OutputData(OutputHapticsData{ .frequency = 100.0F, .duration = 0.5F, .amplitude = 1.0F }));
+
+    REQUIRE(reader.read(1, input) == sequence);
+  }
+
+  SECTION("Wait") {
+    const auto generation = reader.generation();
+    REQUIRE_FALSE(reader.wait(generation, 1'000));
+
+    std::thread thread([&publisher] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      publisher.publish(0, InputPeripheralData{});
+    });
+    REQUIRE(reader.wait(generation, 5'000'000));
+    thread.join();
+  }
+
+  SECTION("Out of range") {
+    InputPeripheralData input;
+    REQUIRE_FALSE(publisher.publish(2, input));
+    REQUIRE(reader.read(2, input) == 0);
+
+    OutputData output;
+    REQUIRE_FALSE(publisher.publish(2, output));
+    REQUIRE(reader.read(2, output) == 0);
+
+    SharedGloveState closed;
+    REQUIRE_FALSE(closed.publish(0, input));
+    REQUIRE(closed.read(0, input) == 0);
+    REQUIRE(closed.generation() == 0);
+    REQUIRE_FALSE(closed.wait(0, 1'000));
+    REQUIRE(closed.stale());
+  }
+
+  SECTION("Replaced segments") {
+    REQUIRE_FALSE(reader.stale());
+    const auto generation = reader.generation();
+
+    // A restarted publisher wakes readers of the old segment, which then reopen the name
+    SharedGloveState restarted;
+    bool created = false;
+    std::thread thread([&name, &restarted, &created] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      created = restarted.create(name.c_str(), 3);
+    });
+    REQUIRE(reader.wait(generation, 5'000'000));
+    thread.join();
+    REQUIRE(created);
+
+    REQUIRE(reader.stale());
+    REQUIRE(reader.open(name.c_str()));
+    REQUIRE_FALSE(reader.stale());
+    REQUIRE(reader.gloveCount() == 3);
+  }
+
+  SECTION("Incompatible segments") {
+    SharedGloveState missing;
+    REQUIRE_FALSE(missing.open("/opengloves-test-missing"));
+    REQUIRE_FALSE(missing.isOpen());
+  }
+
+  SharedGloveState::unlink(name.c_str());
+}
+
+TEST_CASE("SharedGloveState across processes", "[shared_memory]") {
+  const auto name = segmentName();
+
+  SharedGloveState publisher;
+  REQUIRE(publisher.create(name.c_str(), 1));
+
+  // The child reads every value consistently while the parent keeps publishing
+  const auto child = fork();
+  REQUIRE(child >= 0);
+
+  if (child == 0) {
+    SharedGloveState reader;
+    if (!reader.open(name.c_str())) {
+      _exit(2);
+    }
+
+    InputPeripheralData input;
+    while (true) {
+      const auto generation = reader.generation();
+      reader.read(0, input);
+
+      // Every published frame has all curls equal, a torn read would not
+      for (const auto& finger : input.curl.fingers) {
+        if (finger.curl_total != input.curl.thumb.curl_total) {
+          _exit(4);
+        }
+      }
+      if (input.curl.thumb.curl_total == 1.0F) {
+        _exit(0);
+      }
+
+      if (!reader.wait(generation, 5'000'000)) {
+        _exit(3);
+      }
+    }
+  }
+
+  InputPeripheralData input;
+  for (int i = 0; i <= 100'000; i++) {
+    const auto value = static_cast<float>(i) / 100'000.0F;
+    for (auto& finger : input.curl.fingers) {
+      finger.curl_total = value;
+    }
+    publisher.publish(0, input);
+  }
+
+  int status = 0;
+  REQUIRE(waitpid(child, &status, 0) == child);
+  SharedGloveState::unlink(name.c_str());
+
+  REQUIRE(WIFEXITED(status));
+  REQUIRE(WEXITSTATUS(status) == 0);
+}
+
+#else
+
+TEST_CASE("SharedGloveState", "[shared_memory]") {
+  SKIP("Shared memory is not available on this platform");
+}
+
+#endif
@@ -0,0 +1,161 @@
+#include <catch2/catch_all.hpp>
+
+#include <opengloves.hpp>
+#include <opengloves/alpha.hpp>
+#include <opengloves/udp.hpp>
+
+#ifdef OPENGLOVES_HAS_UDP
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace opengloves;
+
+namespace {
+  auto makeInput(float curl) -> InputPeripheralData {
+    InputPeripheralData input;
+    input.curl.index.curl_total = curl;
+    input.joystick.x = 1.0F - curl;
+    input.buttons[0].press = curl > 0.5F;
+    return input;
+  }
+} // namespace
+
+TEST_CASE("UdpBridge", "[udp]") {
+  UdpBatchReceiver<8> receiver;
+  REQUIRE(receiver.bind("127.0.0.1", 0));
+  REQUIRE(receiver.socket().port() != 0);
+
+  UdpBatchSender<4> sender;
+  REQUIRE(sender.open("127.0.0.1", receiver.socket().port()));
+
+  SECTION("Demultiplexes by glove") {
+    for (std::uint16_t glove = 0; glove < 3; glove++) {
+      const auto input = makeInput(static_cast<float>(glove) * 0.25F);
+      REQUIRE(sender.emplace(glove, [&input](uint8_t* buffer, int buffer_size) {
+        return AlphaEncoding::encodeInputPeripheral(input, buffer, buffer_size);
+      }));
+    }
+    REQUIRE(sender.push(0x1234, reinterpret_cast<const uint8_t*>("A4095\n"), 6));
+
+    REQUIRE(sender.pending() == 4);
+    REQUIRE(sender.flush() == 4);
+    REQUIRE(sender.pending() == 0);
+
+    std::vector<std::pair<std::uint16_t, std::string>> received;
+    REQUIRE(receiver.receive(
+        [&received](std::uint16_t glove, const uint8_t* frame, size_t frame_size) {
+          received.emplace_back(glove, std::string(reinterpret_cast<const char*>(frame), frame_size));
+        },
+        1'000'000
+    ) == 4);
+
+    REQUIRE(received.size() == 4);
+    for (std::uint16_t glove = 0; glove < 3; glove++) {
+      REQUIRE(received[glove].first == glove);
+
+      const auto& frame = received[glove].second;
+      const auto decoded = AlphaEncoding::decodeInput(reinterpret_cast<const uint8_t*>(frame.data()), frame.size());
+      const auto* peripheral = std::get_if<InputPeripheralData>(&decoded);
+      REQUIRE(peripheral != nullptr);
+      REQUIRE_THAT(peripheral->curl.index.curl_total, Catch::Matchers::WithinAbs(static_cast<float>(glove) * 0.25F, 0.001F));
+    }
+    REQUIRE(received[3].first == 0x1234);
+    REQUIRE(received[3].second == "A4095\n");
+  }
+
+  SECTION("Full batches are sent on their own") {
+    for (std::uint16_t glove = 0; glove < 6; glove++) {
+      REQUIRE(sender.push(glove, reinterpret_cast<const uint8_t*>("A0\n"), 3));
+    }
+    REQUIRE(sender.pending() == 2);
+
+    std::vector<std::uint16_t> gloves;
+    const auto collect = [&gloves](std::uint16_t glove, const uint8_t* /*frame*/, size_t /*frame_size*/) { gloves.push_back(glove); };
+
+    REQUIRE(receiver.receive(collect, 1'000'000) == 4);
+    REQUIRE(receiver.receive(collect) == 0);
+
+    REQUIRE(sender.flush() == 2);
+    REQUIRE(receiver.receive(collect, 1'000'000) == 2);
+    REQUIRE(gloves == std::vector<std::uint16_t>{ 0, 1, 2, 3, 4, 5 });
+  }
+
+  SECTION("Decodes into a state table") {
+    GloveStateTable table(2);
+
+    for (std::uint16_t glove = 0; glove < 3; glove++) {
+      const auto input = makeInput(0.75F);
+      sender.emplace(glove, [&input](uint8_t* buffer, int buffer_size) {
+        return AlphaEncoding::encodeInputPeripheral(input, buffer, buffer_size);
+      });
+    }
+    sender.flush();
+
+    // Glove 2 is outside the table, and skipped
+    REQUIRE(receiver.receive(table, 1'000'000) == 3);
+
+    for (size_t glove = 0; glove < 2; glove++) {
+      const auto input = table.get(glove);
+      REQUIRE_THAT(input.curl.index.curl_total, Catch::Matchers::WithinAbs(0.75F, 0.001F));
+      REQUIRE_THAT(input.joystick.x, Catch::Matchers::WithinAbs(0.25F, 0.001F));
+      REQUIRE(input.buttons[0].press);
+    }
+  }
+
+  SECTION("Decodes other resolutions into a state table") {
+    GloveStateTable table(1);
+
+    REQUIRE(sender.push(0, reinterpret_cast<const uint8_t*>("A255B0\n"), 7));
+    sender.flush();
+
+    REQUIRE(receiver.receive<AlphaEncoding8>(table, 1'000'000) == 1);
+    REQUIRE(table.curl(0)[0] == 1.0F);
+    REQUIRE(table.curl(1)[0] == 0.0F);
+  }
+
+  SECTION("Malformed datagrams") {
+    UdpSocket raw;
+    REQUIRE(raw.connect("127.0.0.1", receiver.socket().port()));
+
+    // Too short for a header, and too long for the receive buffers
+    const std::string long_datagram(300, 'A');
+    REQUIRE(send(raw.fd(), "x", 1, 0) == 1);
+    REQUIRE(send(raw.fd(), long_datagram.data(), long_datagram.size(), 0) == static_cast<ssize_t>(long_datagram.size()));
+
+    // Frames that do not fit are refused
+    REQUIRE_FALSE(sender.push(0, reinterpret_cast<const uint8_t*>(long_datagram.data()), long_datagram.size()));
+    REQUIRE_FALSE(sender.emplace(0, [](uint8_t* /*buffer*/, int /*buffer_size*/) { return 0; }));
+    REQUIRE(sender.pending() == 0);
+
+    size_t calls = 0;
+    size_t received = 0;
+    while (received < 2) {
+      const auto count = receiver.receive([&calls](std::uint16_t, const uint8_t*, size_t) { calls++; }, 1'000'000);
+      REQUIRE(count > 0);
+      received += count;
+    }
+    REQUIRE(calls == 0);
+  }
+}
+
+TEST_CASE("UdpSocket", "[udp]") {
+  UdpSocket socket;
+  REQUIRE_FALSE(socket.bind("not an address", 0));
+  REQUIRE_FALSE(socket.isOpen());
+  REQUIRE(socket.port() == 0);
+
+  UdpBatchReceiver<> receiver;
+  REQUIRE(receiver.bind("127.0.0.1", 0));
+  REQUIRE(receiver.receive([](std::uint16_t, const uint8_t*, size_t) {}) == 0);
+  REQUIRE(receiver.receive([](std::uint16_t, const uint8_t*, size_t) {}, 1'000) == 0);
+}
+
+#else
+
+TEST_CASE("UdpBridge", "[udp]") {
+  SKIP("UDP sockets are not available on this platform");
+}
+
+#endif